@@ -0,0 +1,85 @@
+#ifndef DRY_COMPARISONS_BENCH_HPP_
+#define DRY_COMPARISONS_BENCH_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A minimal, self contained, benchmark harness. Each measurement is printed
+// as one line of JSON on stdout, e.g.
+// {"suite":"constant_sets","case":"hash","size":64,"ns":1.25}
+// where "ns" is the best observed time per operation, in nanoseconds.
+
+namespace bench {
+
+template <typename T>
+inline void do_not_optimize(const T& t)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(t) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &t;
+#endif
+}
+
+// A reproducible sequence of pseudo random numbers (splitmix64.)
+class random
+{
+public:
+    explicit random(std::uint64_t seed = 0) : state(seed) {}
+    std::uint64_t operator()()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15U);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9U;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebU;
+        return z ^ (z >> 31);
+    }
+    std::size_t below(std::size_t n) { return static_cast<std::size_t>((*this)() % n); }
+private:
+    std::uint64_t state;
+};
+
+// Calls f(i) for i in [0, operations) repeatedly, and reports the best
+// time per call.
+template <typename F>
+void run(const char* suite, const char* name, std::size_t size, std::size_t operations, F&& f)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr int repetitions = 7;
+    double best = 1e300;
+    for (int r = 0; r != repetitions; ++r)
+    {
+        const auto start = clock::now();
+        for (std::size_t i = 0; i != operations; ++i)
+        {
+            do_not_optimize(f(i));
+        }
+        const auto end = clock::now();
+        const std::chrono::duration<double, std::nano> elapsed = end - start;
+        const double ns = elapsed.count() / static_cast<double>(operations);
+        if (ns < best) best = ns;
+    }
+    std::printf("{\"suite\":\"%s\",\"case\":\"%s\",\"size\":%zu,\"ns\":%.3f}\n", suite, name, size, best);
+}
+
+template <typename F>
+void run(const char* suite, const std::string& name, std::size_t size, std::size_t operations, F&& f)
+{
+    run(suite, name.c_str(), size, operations, std::forward<F>(f));
+}
+
+// The suites, each in a file of its own.
+void constant_sets();
+void icase();
+void patterns();
+void quantifiers();
+void sets();
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+# Measures how long the compiler takes for bench/compile_time.cpp with each
+# of the headers, and for bench/compile_time_pack.cpp with quantifiers of
+# SIZES members of different kinds, to track the cost of instantiating large
+# packs. Prints one line of JSON per measurement, e.g.
+# {"suite":"compile_time","case":"dry-comparisons-core.hpp","size":0,"ms":310.5}
+# where "ms" is the best of REPETITIONS compilations, in milliseconds.
+#
+# cmake -DCXX=<compiler> -DFLAGS=<flags> -DSOURCE_DIR=<dir> [-DREPETITIONS=<n>] [-DSIZES=<n;...>]
+#       -P compile_time.cmake
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT DEFINED REPETITIONS)
+  set(REPETITIONS 5)
+endif()
+if(NOT DEFINED SIZES)
+  set(SIZES 16 64 256 1024 2048)
+endif()
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+
+function(measure case size source)
+  set(best "")
+  foreach(r RANGE 1 ${REPETITIONS})
+    string(TIMESTAMP start "%s%f")
+    execute_process(COMMAND ${CXX} ${flags} ${ARGN} -I${SOURCE_DIR} -c ${SOURCE_DIR}/bench/${source} -o compile_time.o
+                    RESULT_VARIABLE result
+                    ERROR_VARIABLE errors)
+    string(TIMESTAMP end "%s%f")
+    if(NOT result EQUAL 0)
+      message(FATAL_ERROR "${case} failed to compile:\n${errors}")
+    endif()
+    math(EXPR us "${end} - ${start}")
+    if(best STREQUAL "" OR us LESS best)
+      set(best ${us})
+    endif()
+  endforeach()
+  math(EXPR ms "${best} / 1000")
+  math(EXPR tenths "(${best} / 100) % 10")
+  message("{\"suite\":\"compile_time\",\"case\":\"${case}\",\"size\":${size},\"ms\":${ms}.${tenths}}")
+endfunction()
+
+foreach(header dry-comparisons.hpp dry-comparisons-core.hpp)
+  measure(${header} 0 compile_time.cpp "-DHEADER=\"${header}\"")
+endforeach()
+
+foreach(size ${SIZES})
+  math(EXPR last "${size} - 1")
+  set(pack "M(0)")
+  foreach(i RANGE 1 ${last})
+    string(APPEND pack ",\nM(${i})")
+  endforeach()
+  file(WRITE pack.inc "${pack}\n")
+  foreach(kind ENUMS REFERENCES MIXED)
+    string(TOLOWER "${kind}" case)
+    measure(${case} ${size} compile_time_pack.cpp -D${kind} "-DPACK=\"${CMAKE_CURRENT_BINARY_DIR}/pack.inc\"")
+  endforeach()
+endforeach()
+file(REMOVE compile_time.o pack.inc)
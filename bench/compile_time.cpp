@@ -0,0 +1,31 @@
+// A translation unit typical of code using the quantifiers, compiled by
+// compile_time.cmake with HEADER defined as the header to include.
+#include HEADER
+
+#include <string_view>
+
+using rollbear::all_of;
+using rollbear::any_of;
+using rollbear::none_of;
+
+enum class colour { red, green, blue };
+
+bool valid_port(int port, int admin, int user)
+{
+    return port == any_of(admin, user, 8080);
+}
+
+bool is_primary(colour c)
+{
+    return c != none_of(colour::red, colour::green, colour::blue);
+}
+
+bool is_method(std::string_view s)
+{
+    return s == any_of("GET", "PUT", "POST");
+}
+
+bool in_range(double d, double lo, double hi)
+{
+    return all_of(lo, hi) < d || d <= any_of(lo, hi);
+}
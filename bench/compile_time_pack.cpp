@@ -0,0 +1,38 @@
+// A translation unit comparing with quantifiers of many members, compiled
+// by compile_time.cmake with PACK defined as a file listing the members as
+// M(0), M(1), ..., and one of ENUMS, REFERENCES or MIXED defined, to choose
+// what the members are.
+#include "dry-comparisons.hpp"
+
+#include <type_traits>
+
+using rollbear::all_of;
+using rollbear::any_of;
+using rollbear::none_of;
+
+enum class colour : int {};
+
+template <int I>
+using mixed_t = std::conditional_t<I % 4 == 0, int,
+                std::conditional_t<I % 4 == 1, long,
+                std::conditional_t<I % 4 == 2, short, unsigned char>>>;
+
+#if defined(ENUMS)
+#define M(i) colour{i}
+bool compare(colour u)
+#elif defined(REFERENCES)
+#define M(i) values[i]
+bool compare(int u, const int* values)
+#elif defined(MIXED)
+#define M(i) mixed_t<i>{i % 100}
+bool compare(long u)
+#endif
+{
+    return u == any_of(
+#include PACK
+    ) || u < all_of(
+#include PACK
+    ) || u != none_of(
+#include PACK
+    );
+}
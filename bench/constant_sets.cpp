@@ -0,0 +1,64 @@
+#include "../dry-comparisons.hpp"
+#include "bench.hpp"
+
+// Compares the strategies for testing membership in a set of sparse compile
+// time constants, for growing set sizes, to find where a comparison tree,
+// a branch free binary search and a perfect hash beat the plain fold.
+
+namespace {
+
+constexpr int sparse(std::size_t i)
+{
+    return static_cast<int>((i * 2654435761U) % 1000003U);
+}
+
+template <typename Set>
+void measure(std::size_t size, const std::vector<int>& probes)
+{
+    const auto n = probes.size();
+    const auto mask = n - 1;
+    bench::run("constant_sets", "fold", size, n, [&](std::size_t i) {
+        return Set::linear_search(probes[i & mask]);
+    });
+    bench::run("constant_sets", "tree", size, n, [&](std::size_t i) {
+        return Set::tree_search(probes[i & mask]);
+    });
+    bench::run("constant_sets", "sorted", size, n, [&](std::size_t i) {
+        return Set::sorted_search(probes[i & mask]);
+    });
+    if (Set::make_perfect_hash().found)
+    {
+        static constexpr auto table = Set::make_perfect_hash();
+        bench::run("constant_sets", "hash", size, n, [&](std::size_t i) {
+            const int u = probes[i & mask];
+            return table.slots[Set::hash(u, table.multiplier, table.shift)] == u;
+        });
+    }
+}
+
+template <std::size_t ... I>
+void measure(std::index_sequence<I...>)
+{
+    using set = rollbear::internal::constant_set<int, sparse(I)...>;
+    // Half of the probes are members of the set.
+    bench::random random;
+    std::vector<int> probes(4096);
+    for (auto& p : probes)
+    {
+        p = random() & 1 ? sparse(random.below(sizeof...(I))) : static_cast<int>(random.below(1000003U));
+    }
+    measure<set>(sizeof...(I), probes);
+}
+
+}
+
+void bench::constant_sets()
+{
+    measure(std::make_index_sequence<4>{});
+    measure(std::make_index_sequence<8>{});
+    measure(std::make_index_sequence<16>{});
+    measure(std::make_index_sequence<32>{});
+    measure(std::make_index_sequence<64>{});
+    measure(std::make_index_sequence<128>{});
+    measure(std::make_index_sequence<256>{});
+}
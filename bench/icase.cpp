@@ -0,0 +1,71 @@
+#include "../dry-comparisons.hpp"
+#include "bench.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compares an any_of of icase strings with lower casing a copy of the
+// string and comparing it with an any_of of lower case string literals,
+// for header names of mixed case, none of which match, and half of which
+// match a random member. Each case is reported twice, with the case name
+// ending in "/icase" and in "/copy", and the size is the number of members.
+
+namespace {
+
+using rollbear::any_of;
+using rollbear::icase;
+
+constexpr std::size_t name_count = 1024;
+
+const std::string_view lower_names[] = {
+    "accept", "accept-encoding", "authorization", "cache-control", "connection", "content-length",
+    "content-type", "cookie", "host", "if-none-match", "origin", "referer", "user-agent",
+    "x-forwarded-for", "x-request-id", "x-real-ip"
+};
+
+std::string mixed_case(bench::random& random, std::string_view s)
+{
+    std::string r(s);
+    for (auto& c : r) if (c >= 'a' && c <= 'z' && (random() & 1)) c = static_cast<char>(c - 'a' + 'A');
+    return r;
+}
+
+template <std::size_t ... I>
+void measure(std::index_sequence<I...>)
+{
+    constexpr std::size_t n = sizeof...(I);
+    const auto folded = any_of(icase(lower_names[I])...);
+    const auto lower = any_of(lower_names[I]...);
+    bench::random random;
+    std::vector<std::string> miss(name_count), mixed(name_count);
+    for (std::size_t k = 0; k != name_count; ++k)
+    {
+        miss[k] = mixed_case(random, lower_names[random.below(16)]) + "-x";
+        mixed[k] = (random() & 1) ? mixed_case(random, lower_names[random.below(n)]) : miss[k];
+    }
+    const std::pair<const char*, const std::vector<std::string>&> distributions[] = {
+        { "miss", miss }, { "random", mixed }
+    };
+    for (auto& [distribution, names] : distributions)
+    {
+        const std::string name = std::string("any_of==") + distribution;
+        bench::run("icase", name + "/icase", n, name_count, [&, &names = names](std::size_t k) {
+            return names[k % name_count] == folded;
+        });
+        bench::run("icase", name + "/copy", n, name_count, [&, &names = names](std::size_t k) {
+            std::string s = names[k % name_count];
+            for (auto& c : s) if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            return s == lower;
+        });
+    }
+}
+
+}
+
+void bench::icase()
+{
+    measure(std::make_index_sequence<4>{});
+    measure(std::make_index_sequence<8>{});
+    measure(std::make_index_sequence<16>{});
+}
@@ -0,0 +1,30 @@
+#include "bench.hpp"
+
+#include <cstring>
+
+// Runs all suites, or only those named on the command line, e.g.
+// bench quantifiers > quantifiers.json
+int main(int argc, char* argv[])
+{
+    struct suite
+    {
+        const char* name;
+        void (*run)();
+    };
+    const suite suites[] = {
+        { "constant_sets", bench::constant_sets },
+        { "icase", bench::icase },
+        { "patterns", bench::patterns },
+        { "quantifiers", bench::quantifiers },
+        { "sets", bench::sets },
+    };
+    for (auto& s : suites)
+    {
+        bool selected = argc == 1;
+        for (int i = 1; i != argc; ++i)
+        {
+            selected = selected || std::strcmp(argv[i], s.name) == 0;
+        }
+        if (selected) s.run();
+    }
+}
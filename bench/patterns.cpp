@@ -0,0 +1,87 @@
+#include "../dry-comparisons.hpp"
+#include "bench.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compares an any_of of N text patterns, which above
+// DRY_COMPARISONS_SEARCH_THRESHOLD scans a string once with an Aho-Corasick
+// automaton, with the hand written chain of starts_with, ends_with and find
+// calls it stands for, for paths that match no pattern and for paths where
+// half match a random one. Each case is reported twice, with the case name
+// ending in "/quantifier" and in "/chain", and the size is N.
+
+namespace {
+
+using rollbear::any_of;
+using rollbear::contains;
+using rollbear::ends_with;
+using rollbear::starts_with;
+
+constexpr std::size_t path_count = 1024;
+
+std::string word(bench::random& random, std::size_t size)
+{
+    std::string s;
+    for (std::size_t i = 0; i != size; ++i) s += static_cast<char>('a' + random.below(26));
+    return s;
+}
+
+template <std::size_t ... I>
+void measure(const char* kind, rollbear::text_pattern (*make)(std::string_view), std::index_sequence<I...>)
+{
+    constexpr std::size_t n = sizeof...(I);
+    bench::random random;
+    std::vector<std::string> texts;
+    for (std::size_t i = 0; i != n; ++i) texts.push_back('/' + word(random, 4 + random.below(8)) + '/');
+    const auto patterns = any_of(make(texts[I])...);
+    std::vector<std::string> miss(path_count), mixed(path_count);
+    for (std::size_t k = 0; k != path_count; ++k)
+    {
+        miss[k] = '/' + word(random, 40 + random.below(40)) + ".html";
+        mixed[k] = miss[k];
+        if (random() & 1)
+        {
+            const std::string& text = texts[random.below(n)];
+            const std::size_t last = mixed[k].size() - text.size();
+            const auto position = make(text).position;
+            const std::size_t at = position == rollbear::text_position::prefix ? 0
+                                 : position == rollbear::text_position::suffix ? last
+                                 : random.below(last + 1);
+            mixed[k].replace(at, text.size(), text);
+        }
+    }
+    const std::pair<const char*, const std::vector<std::string>&> distributions[] = {
+        { "miss", miss }, { "random", mixed }
+    };
+    for (auto& [distribution, paths] : distributions)
+    {
+        const std::string name = std::string(kind) + '/' + distribution;
+        bench::run("patterns", name + "/quantifier", n, path_count, [&, &paths = paths](std::size_t k) {
+            return std::string_view(paths[k % path_count]) == patterns;
+        });
+        bench::run("patterns", name + "/chain", n, path_count, [&, &paths = paths](std::size_t k) {
+            const std::string_view s = paths[k % path_count];
+            return (make(texts[I]).matches(s) || ...);
+        });
+    }
+}
+
+template <std::size_t N>
+void measure()
+{
+    measure("starts_with", starts_with, std::make_index_sequence<N>{});
+    measure("ends_with", ends_with, std::make_index_sequence<N>{});
+    measure("contains", contains, std::make_index_sequence<N>{});
+}
+
+}
+
+void bench::patterns()
+{
+    measure<4>();
+    measure<8>();
+    measure<16>();
+    measure<64>();
+}
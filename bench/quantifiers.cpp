@@ -0,0 +1,218 @@
+#include "../dry-comparisons.hpp"
+#include "bench.hpp"
+
+#include <array>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// Compares the quantifiers with the hand written || and && chains they
+// stand for, for all operators, for packs of 2 to 256 members of
+// different types, and for probes that match no member, the first, the
+// last, or a random one. Each case is reported twice, with the case name
+// ending in "/quantifier" and in "/chain".
+
+namespace {
+
+using rollbear::all_of;
+using rollbear::any_of;
+using rollbear::none_of;
+
+enum colour { red, green, blue };
+
+template <typename T>
+T make(int i);
+template <>
+int make<int>(int i) { return i * 3 + 1; }
+template <>
+colour make<colour>(int i) { return static_cast<colour>(i * 3 + 1); }
+template <>
+double make<double>(int i) { return i * 3 + 1.5; }
+template <>
+std::string make<std::string>(int i) { return "value-" + std::to_string(i * 3 + 1); }
+template <>
+std::string_view make<std::string_view>(int i)
+{
+    static std::deque<std::string> strings;
+    return strings.emplace_back(make<std::string>(i));
+}
+
+constexpr std::size_t probe_count = 4096;
+
+template <typename T, std::size_t N>
+std::vector<std::pair<const char*, std::vector<T>>> distributions(const std::array<T, N>& v)
+{
+    bench::random random;
+    std::vector<T> miss, first, last, mixed;
+    for (std::size_t i = 0; i != probe_count; ++i)
+    {
+        miss.push_back(make<T>(-1));
+        first.push_back(v.front());
+        last.push_back(v.back());
+        mixed.push_back(random() & 1 ? v[random.below(N)] : make<T>(-1));
+    }
+    return { { "miss", miss }, { "first", first }, { "last", last }, { "random", mixed } };
+}
+
+// All operators are measured for packs of up to 64 members. Larger packs
+// are only measured for == with any_of and all_of, to keep the build time
+// reasonable.
+template <bool all_operators, typename T, std::size_t ... I>
+void measure(const char* type, std::index_sequence<I...>)
+{
+    constexpr std::size_t size = sizeof...(I);
+    const std::array<T, size> v{ make<T>(int(I))... };
+    for (auto& [distribution, probes] : distributions(v))
+    {
+        auto compare = [&, &probes = probes, distribution = distribution](const char* op, auto quantified, auto chain) {
+            const std::string name = std::string(op) + '/' + type + '/' + distribution;
+            bench::run("quantifiers", name + "/quantifier", size, probe_count, [&](std::size_t i) {
+                return quantified(probes[i % probe_count]);
+            });
+            bench::run("quantifiers", name + "/chain", size, probe_count, [&](std::size_t i) {
+                return chain(probes[i % probe_count]);
+            });
+        };
+        compare("any_of==", [&](const T& x) { return x == any_of(v[I]...); },
+                            [&](const T& x) { return ((x == v[I]) || ...); });
+        compare("all_of==", [&](const T& x) { return x == all_of(v[I]...); },
+                            [&](const T& x) { return ((x == v[I]) && ...); });
+        if constexpr (all_operators)
+        {
+            compare("none_of==", [&](const T& x) { return x == none_of(v[I]...); },
+                                 [&](const T& x) { return !((x == v[I]) || ...); });
+            compare("any_of<", [&](const T& x) { return x < any_of(v[I]...); },
+                               [&](const T& x) { return ((x < v[I]) || ...); });
+            compare("any_of!=", [&](const T& x) { return x != any_of(v[I]...); },
+                                [&](const T& x) { return ((x != v[I]) && ...); });
+            compare("all_of!=", [&](const T& x) { return x != all_of(v[I]...); },
+                                [&](const T& x) { return ((x != v[I]) || ...); });
+            compare("none_of!=", [&](const T& x) { return x != none_of(v[I]...); },
+                                 [&](const T& x) { return ((x == v[I]) || ...); });
+            compare("all_of<=", [&](const T& x) { return x <= all_of(v[I]...); },
+                                [&](const T& x) { return ((x <= v[I]) && ...); });
+            compare("none_of>", [&](const T& x) { return x > none_of(v[I]...); },
+                                [&](const T& x) { return !((x > v[I]) || ...); });
+            compare("any_of>=", [&](const T& x) { return x >= any_of(v[I]...); },
+                                [&](const T& x) { return ((x >= v[I]) || ...); });
+        }
+    }
+}
+
+template <typename T, bool large>
+void measure(const char* type)
+{
+    measure<true, T>(type, std::make_index_sequence<2>{});
+    measure<true, T>(type, std::make_index_sequence<4>{});
+    measure<true, T>(type, std::make_index_sequence<16>{});
+    measure<true, T>(type, std::make_index_sequence<64>{});
+    if constexpr (large) measure<false, T>(type, std::make_index_sequence<256>{});
+}
+
+struct equals
+{
+    int k;
+    bool operator()(int x) const { return x == k; }
+};
+
+// The callable path, i.e. any_of{f, g, ...}(x), through internal::bound.
+template <std::size_t ... I>
+void measure_callables(std::index_sequence<I...>)
+{
+    constexpr std::size_t size = sizeof...(I);
+    const std::array<equals, size> f{ equals{make<int>(int(I))}... };
+    const auto any = any_of{f[I]...};
+    const auto all = all_of{f[I]...};
+    const auto none = none_of{f[I]...};
+    const std::array<int, size> v{ make<int>(int(I))... };
+    for (auto& [distribution, probes] : distributions(v))
+    {
+        const std::string name = std::string("/int/") + distribution;
+        auto probe = [&probes = probes](std::size_t i) { return probes[i % probe_count]; };
+        bench::run("quantifiers", "any_of()" + name + "/quantifier", size, probe_count,
+                   [&](std::size_t i) { return bool(any(probe(i))); });
+        bench::run("quantifiers", "any_of()" + name + "/chain", size, probe_count,
+                   [&](std::size_t i) { const int x = probe(i); return (f[I](x) || ...); });
+        bench::run("quantifiers", "all_of()" + name + "/quantifier", size, probe_count,
+                   [&](std::size_t i) { return bool(all(probe(i))); });
+        bench::run("quantifiers", "all_of()" + name + "/chain", size, probe_count,
+                   [&](std::size_t i) { const int x = probe(i); return (f[I](x) && ...); });
+        bench::run("quantifiers", "none_of()" + name + "/quantifier", size, probe_count,
+                   [&](std::size_t i) { return bool(none(probe(i))); });
+        bench::run("quantifiers", "none_of()" + name + "/chain", size, probe_count,
+                   [&](std::size_t i) { const int x = probe(i); return !(f[I](x) || ...); });
+    }
+}
+
+// adaptive_any_of against any_of, and against the hand written || chain in
+// the order the members are listed, for probes that match the last member
+// seven times out of eight, and no member otherwise.
+template <typename T, std::size_t ... I>
+void measure_adaptive(const char* type, std::index_sequence<I...>)
+{
+    constexpr std::size_t size = sizeof...(I);
+    const std::array<T, size> v{ make<T>(int(I))... };
+    const auto plain = any_of(v[I]...);
+    const auto adaptive = rollbear::adaptive_any_of(v[I]...);
+    bench::random random;
+    std::vector<T> probes;
+    for (std::size_t i = 0; i != probe_count; ++i)
+    {
+        probes.push_back(random.below(8) != 0 ? v.back() : make<T>(-1));
+    }
+    const std::string name = std::string("adaptive_any_of==/") + type + "/skewed";
+    bench::run("quantifiers", name + "/quantifier", size, probe_count,
+               [&](std::size_t i) { return probes[i % probe_count] == adaptive; });
+    bench::run("quantifiers", name + "/any_of", size, probe_count,
+               [&](std::size_t i) { return probes[i % probe_count] == plain; });
+    bench::run("quantifiers", name + "/chain", size, probe_count,
+               [&](std::size_t i) { const T& x = probes[i % probe_count]; return ((x == v[I]) || ...); });
+}
+
+template <typename T, std::size_t ... I>
+void measure_printing(const char* type, std::index_sequence<I...>)
+{
+    constexpr std::size_t size = sizeof...(I);
+    const std::array<T, size> v{ make<T>(int(I))... };
+    std::ostringstream os;
+    const std::string name = std::string("print/") + type;
+    bench::run("quantifiers", name + "/quantifier", size, 1024, [&](std::size_t) {
+        os.str({});
+        os << any_of(v[I]...);
+        return os.tellp();
+    });
+    bench::run("quantifiers", name + "/chain", size, 1024, [&](std::size_t) {
+        os.str({});
+        os << "any_of{";
+        for (std::size_t i = 0; i != size; ++i) os << &","[i == 0] << v[i];
+        os << '}';
+        return os.tellp();
+    });
+}
+
+}
+
+void bench::quantifiers()
+{
+    measure<int, true>("int");
+    measure<colour, false>("enum");
+    measure<double, false>("double");
+    measure<std::string, false>("string");
+    measure<std::string_view, true>("string_view");
+
+    measure_callables(std::make_index_sequence<2>{});
+    measure_callables(std::make_index_sequence<4>{});
+    measure_callables(std::make_index_sequence<8>{});
+    measure_callables(std::make_index_sequence<16>{});
+
+    measure_adaptive<int>("int", std::make_index_sequence<4>{});
+    measure_adaptive<int>("int", std::make_index_sequence<16>{});
+    measure_adaptive<std::string_view>("string_view", std::make_index_sequence<4>{});
+    measure_adaptive<std::string_view>("string_view", std::make_index_sequence<16>{});
+
+    measure_printing<int>("int", std::make_index_sequence<4>{});
+    measure_printing<int>("int", std::make_index_sequence<64>{});
+    measure_printing<std::string>("string", std::make_index_sequence<4>{});
+    measure_printing<std::string>("string", std::make_index_sequence<64>{});
+}
@@ -0,0 +1,97 @@
+#include "../dry-comparisons.hpp"
+#include "bench.hpp"
+
+#include <array>
+#include <deque>
+#include <string>
+#include <string_view>
+
+// Compares a quantifier of N members with an any_of of M members, i.e.
+// whether any of the tags of a message is in a routing set, with the hand
+// written nested chain it stands for, for messages where no tag is in the
+// set, and where a random one of them is in half of the messages. Each case
+// is reported twice, with the case name ending in "/quantifier" and in
+// "/chain", and the size is N * M. The sizes on both sides of
+// DRY_COMPARISONS_SET_THRESHOLD show whether strings are better looked up in
+// a hash table than compared pair by pair, and whether integers still are
+// not.
+
+namespace {
+
+using rollbear::all_of;
+using rollbear::any_of;
+
+template <typename T>
+T make(std::size_t i);
+template <>
+int make<int>(std::size_t i) { return int(i * 7 + 1); }
+template <>
+std::string_view make<std::string_view>(std::size_t i)
+{
+    static std::deque<std::string> strings;
+    return strings.emplace_back("tag-" + std::to_string(i * 7 + 1));
+}
+
+constexpr std::size_t message_count = 1024;
+
+template <typename T, std::size_t ... I, std::size_t ... J>
+void measure(const char* type, std::index_sequence<I...>, std::index_sequence<J...>)
+{
+    constexpr std::size_t n = sizeof...(I);
+    constexpr std::size_t m = sizeof...(J);
+    const std::array<T, m> routes{ make<T>(J)... };
+    bench::random random;
+    std::vector<std::array<T, n>> miss(message_count), mixed(message_count);
+    for (std::size_t k = 0; k != message_count; ++k)
+    {
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            miss[k][i] = make<T>(m + random.below(4 * m));
+            mixed[k][i] = miss[k][i];
+        }
+        if (random() & 1) mixed[k][random.below(n)] = routes[random.below(m)];
+    }
+    const std::pair<const char*, const std::vector<std::array<T, n>>&> distributions[] = {
+        { "miss", miss }, { "random", mixed }
+    };
+    for (auto& [distribution, messages] : distributions)
+    {
+        auto compare = [&, &messages = messages, distribution = distribution](const char* op, auto quantified, auto chain) {
+            const std::string name = std::string(op) + '/' + type + '/' + distribution;
+            bench::run("sets", name + "/quantifier", n * m, message_count, [&](std::size_t k) {
+                return quantified(messages[k % message_count]);
+            });
+            bench::run("sets", name + "/chain", n * m, message_count, [&](std::size_t k) {
+                return chain(messages[k % message_count]);
+            });
+        };
+        auto routed = [&](const T& x) { return ((x == routes[J]) || ...); };
+        compare("any_of==any_of", [&](const std::array<T, n>& t) { return any_of(t[I]...) == any_of(routes[J]...); },
+                                  [&](const std::array<T, n>& t) { return (routed(t[I]) || ...); });
+        compare("all_of!=any_of", [&](const std::array<T, n>& t) { return all_of(t[I]...) != any_of(routes[J]...); },
+                                  [&](const std::array<T, n>& t) { return !(routed(t[I]) || ...); });
+        compare("any_of==any_of_range", [&](const std::array<T, n>& t) { return any_of(t[I]...) == rollbear::any_of_range(routes); },
+                                        [&](const std::array<T, n>& t) { return (routed(t[I]) || ...); });
+    }
+}
+
+template <typename T>
+void measure(const char* type)
+{
+    measure<T>(type, std::make_index_sequence<4>{}, std::make_index_sequence<4>{});
+    measure<T>(type, std::make_index_sequence<4>{}, std::make_index_sequence<16>{});
+    measure<T>(type, std::make_index_sequence<8>{}, std::make_index_sequence<8>{});
+    measure<T>(type, std::make_index_sequence<4>{}, std::make_index_sequence<64>{});
+    measure<T>(type, std::make_index_sequence<16>{}, std::make_index_sequence<16>{});
+    measure<T>(type, std::make_index_sequence<8>{}, std::make_index_sequence<64>{});
+    measure<T>(type, std::make_index_sequence<30>{}, std::make_index_sequence<200>{});
+    measure<T>(type, std::make_index_sequence<200>{}, std::make_index_sequence<30>{});
+}
+
+}
+
+void bench::sets()
+{
+    measure<int>("int");
+    measure<std::string_view>("string_view");
+}
@@ -0,0 +1,101 @@
+# Compares the code generated for the functions of corpus.cpp.
+#
+# cmake -DOBJDUMP=<objdump> -DOBJECTS=<object files> [-DCORPUS=<corpus.cpp>] [-DLABEL=<label>]
+#       [-DTOLERANCE=<percent>] -P compare.cmake
+#
+# Each object file is disassembled, and the instructions and calls of every
+# function quantified_<case> are counted and compared with those of
+# hand_written_<case>. The check fails if a quantified function makes more
+# calls than its hand written twin, or has more instructions, beyond
+# TOLERANCE percent, but at least one instruction, since the compiler may
+# choose a branch for one and a conditional move or set for the other.
+# A case listed in CORPUS with a comment line
+# "// EXCEPTION(<case>, <extra instructions>): <reason>" may have that many
+# more instructions.
+# Padding between functions is not counted.
+
+if(NOT DEFINED TOLERANCE)
+  set(TOLERANCE 10)
+endif()
+
+if(DEFINED CORPUS)
+  file(STRINGS ${CORPUS} exceptions REGEX "^// EXCEPTION\\([A-Za-z0-9_]+, *[0-9]+\\)")
+  foreach(exception IN LISTS exceptions)
+    string(REGEX MATCH "^// EXCEPTION\\(([A-Za-z0-9_]+), *([0-9]+)\\)" exception "${exception}")
+    set(extra_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+  endforeach()
+endif()
+
+set(failures 0)
+foreach(object IN LISTS OBJECTS)
+  execute_process(COMMAND ${OBJDUMP} -d --no-show-raw-insn ${object}
+                  OUTPUT_VARIABLE listing
+                  RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} failed for ${object}")
+  endif()
+  # One list element per line. Semicolons would split lines, so they go.
+  string(REPLACE ";" "," listing "${listing}")
+  string(REPLACE "\n" ";" lines "${listing}")
+
+  set(functions)
+  set(current)
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <([A-Za-z0-9_]+)>:$")
+      set(current ${CMAKE_MATCH_1})
+      list(APPEND functions ${current})
+      set(instructions_${current} 0)
+      set(calls_${current} 0)
+    elseif(current AND line MATCHES "^ *[0-9a-f]+:[ \t]+([^ \t].*)$")
+      set(instruction "${CMAKE_MATCH_1}")
+      if(instruction MATCHES "^(cs |data16 |rex[.a-zA-Z]* )*(nop|int3|xchg +%ax,%ax)")
+        continue()
+      endif()
+      math(EXPR instructions_${current} "${instructions_${current}} + 1")
+      if(instruction MATCHES "^(call|callq|bl|blr|blx|jalr?)[ \t]")
+        math(EXPR calls_${current} "${calls_${current}} + 1")
+      endif()
+    endif()
+  endforeach()
+
+  get_filename_component(name ${object} NAME)
+  if(DEFINED LABEL)
+    set(name "${name} ${LABEL}")
+  endif()
+  foreach(quantified IN LISTS functions)
+    if(NOT quantified MATCHES "^quantified_(.*)$")
+      continue()
+    endif()
+    set(case ${CMAKE_MATCH_1})
+    set(hand_written hand_written_${case})
+    if(NOT DEFINED instructions_${hand_written})
+      message(SEND_ERROR "${name}: ${quantified} has no ${hand_written}")
+      math(EXPR failures "${failures} + 1")
+      continue()
+    endif()
+    set(q ${instructions_${quantified}})
+    set(h ${instructions_${hand_written}})
+    math(EXPR slack "(${h} * ${TOLERANCE}) / 100")
+    if(slack LESS 1)
+      set(slack 1)
+    endif()
+    if(DEFINED extra_${case})
+      math(EXPR slack "${slack} + ${extra_${case}}")
+    endif()
+    math(EXPR limit "${h} + ${slack}")
+    set(summary "${quantified}: ${q} instructions, ${calls_${quantified}} calls, hand written ${h} instructions, ${calls_${hand_written}} calls")
+    if(DEFINED extra_${case})
+      string(APPEND summary " (exception, ${extra_${case}} more allowed)")
+    endif()
+    if(q GREATER limit OR calls_${quantified} GREATER calls_${hand_written})
+      message(SEND_ERROR "${name}: ${summary}")
+      math(EXPR failures "${failures} + 1")
+    else()
+      message(STATUS "${name}: ${summary}")
+    endif()
+  endforeach()
+endforeach()
+
+if(failures GREATER 0)
+  message(FATAL_ERROR "${failures} quantified functions generate worse code than the hand written ones")
+endif()
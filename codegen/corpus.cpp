@@ -0,0 +1,182 @@
+#include "../dry-comparisons.hpp"
+
+#include <string_view>
+
+// Pairs of functions that should compile to the same code, one written with
+// the quantifiers, named quantified_<case>, and one hand written, named
+// hand_written_<case>. compare.cmake disassembles the object file and
+// compares the instruction and call counts of each pair. The functions are
+// extern "C" so that their names can be found without demangling.
+//
+// A case that is known to generate more instructions, for a reason
+// outside of the library, is listed in a comment line of the form
+// "// EXCEPTION(<case>, <extra instructions>): <reason>".
+
+using rollbear::all_of;
+using rollbear::any_of;
+using rollbear::none_of;
+using rollbear::any_of_c;
+
+namespace {
+
+enum class state { idle, connecting, connected, closing, closed };
+
+struct is_even
+{
+    bool operator()(int x) const { return x % 2 == 0; }
+};
+struct is_positive
+{
+    bool operator()(int x) const { return x > 0; }
+};
+struct is_small
+{
+    bool operator()(int x) const { return x < 100; }
+};
+
+}
+
+extern "C" {
+
+bool quantified_any_of_eq(int x, int a, int b, int c)
+{
+    return x == any_of(a, b, c);
+}
+bool hand_written_any_of_eq(int x, int a, int b, int c)
+{
+    return x == a || x == b || x == c;
+}
+
+bool quantified_any_of_ne(int x, int a, int b, int c)
+{
+    return x != any_of(a, b, c);
+}
+bool hand_written_any_of_ne(int x, int a, int b, int c)
+{
+    return x != a && x != b && x != c;
+}
+
+bool quantified_all_of_lt(int x, int a, int b, int c, int d)
+{
+    return x < all_of(a, b, c, d);
+}
+bool hand_written_all_of_lt(int x, int a, int b, int c, int d)
+{
+    return x < a && x < b && x < c && x < d;
+}
+
+bool quantified_any_of_eq_constants(int x)
+{
+    return x == any_of(2, 3, 5, 7, 11, 13, 17, 19);
+}
+bool hand_written_any_of_eq_constants(int x)
+{
+    return x == 2 || x == 3 || x == 5 || x == 7 || x == 11 || x == 13 || x == 17 || x == 19;
+}
+
+bool quantified_none_of_eq(long x, long a, long b)
+{
+    return x == none_of(a, b);
+}
+bool hand_written_none_of_eq(long x, long a, long b)
+{
+    return !(x == a || x == b);
+}
+
+bool quantified_all_of_gt_double(double x, double a, double b)
+{
+    return all_of(a, b) > x;
+}
+bool hand_written_all_of_gt_double(double x, double a, double b)
+{
+    return a > x && b > x;
+}
+
+bool quantified_any_of_eq_enum(state s)
+{
+    return s == any_of(state::connecting, state::closing);
+}
+bool hand_written_any_of_eq_enum(state s)
+{
+    return s == state::connecting || s == state::closing;
+}
+
+bool quantified_any_of_c_enum(state s)
+{
+    return s == any_of_c<state::idle, state::connected, state::closed>;
+}
+bool hand_written_any_of_c_enum(state s)
+{
+    return s == state::idle || s == state::connected || s == state::closed;
+}
+
+bool quantified_any_of_bool(bool a, bool b, bool c)
+{
+    return bool(any_of(a, b, c));
+}
+bool hand_written_any_of_bool(bool a, bool b, bool c)
+{
+    return a || b || c;
+}
+
+bool quantified_any_of_pointer(const int* p, const int* a, const int* b)
+{
+    return p == any_of(a, b);
+}
+bool hand_written_any_of_pointer(const int* p, const int* a, const int* b)
+{
+    return p == a || p == b;
+}
+
+bool quantified_any_of_callables(int x)
+{
+    return bool(any_of(is_even{}, is_positive{})(x));
+}
+bool hand_written_any_of_callables(int x)
+{
+    return is_even{}(x) || is_positive{}(x);
+}
+
+bool quantified_all_of_callables(int x)
+{
+    return bool(all_of(is_even{}, is_positive{}, is_small{})(x));
+}
+bool hand_written_all_of_callables(int x)
+{
+    return is_even{}(x) && is_positive{}(x) && is_small{}(x);
+}
+
+// EXCEPTION(all_of_callables_eq, 3): GCC folds the hand written
+// is_even{}(x) == true to is_even{}(x) while parsing, and if-converts the
+// result, but the quantified == receives true as a const bool&, and is
+// compiled as a comparison with any bool, which branches. Compared with a
+// bool that is not a constant, both generate the same code, see
+// all_of_callables_eq_bool.
+bool quantified_all_of_callables_eq(int x)
+{
+    return all_of(is_even{}, is_positive{})(x) == true;
+}
+bool hand_written_all_of_callables_eq(int x)
+{
+    return is_even{}(x) == true && is_positive{}(x) == true;
+}
+
+bool quantified_all_of_callables_eq_bool(int x, bool b)
+{
+    return all_of(is_even{}, is_positive{})(x) == b;
+}
+bool hand_written_all_of_callables_eq_bool(int x, bool b)
+{
+    return is_even{}(x) == b && is_positive{}(x) == b;
+}
+
+bool quantified_any_of_string_view(std::string_view s)
+{
+    return s == any_of("GET", "PUT", "POST");
+}
+bool hand_written_any_of_string_view(std::string_view s)
+{
+    return s == "GET" || s == "PUT" || s == "POST";
+}
+
+}
@@ -0,0 +1,120 @@
+#ifndef DRY_COMPARISONS_BIND_HPP_
+#define DRY_COMPARISONS_BIND_HPP_
+
+#include "dry-comparisons-core.hpp"
+
+#include <optional>
+
+namespace rollbear {
+namespace internal {
+
+// A callable bound to the arguments of a call. It refers to both, which
+// are owned by the bound_storage of the quantifier it is a member of.
+template <typename F, typename ... Args>
+struct bound
+{
+    using RT = std::invoke_result_t<const F&, const Args&...>;
+
+    constexpr operator RT() const
+    noexcept(std::is_nothrow_invocable_v<const F&, const Args&...>)
+    {
+        return std::apply(f, args);
+    }
+
+    const F& f;
+    const std::tuple<Args...>& args;
+};
+
+// Like bound, but the result of the first call is kept, and returned by
+// all later conversions.
+template <typename F, typename ... Args>
+struct memo_bound
+{
+    using RT = std::decay_t<std::invoke_result_t<const F&, const Args&...>>;
+
+    operator RT() const
+    noexcept(std::is_nothrow_invocable_v<const F&, const Args&...> &&
+             std::is_nothrow_copy_constructible_v<RT>)
+    {
+        if (!result) result.emplace(std::apply(f, args));
+        return *result;
+    }
+
+    const F& f;
+    const std::tuple<Args...>& args;
+    std::optional<RT>& result;
+};
+
+// The result of calling a quantifier of callables. The arguments are stored
+// once, and shared by all callables, instead of once per callable. Empty
+// callables take no space.
+template <typename Args, typename ... Fs>
+class bound_storage;
+template <typename ... Args, typename ... Fs>
+class bound_storage<std::tuple<Args...>, Fs...> : std::tuple<Fs...>
+{
+    using callables = std::tuple<Fs...>;
+public:
+    template <typename ... Gs, typename ... As>
+    constexpr bound_storage(const std::tuple<Gs...>& fs, As&& ... as)
+    noexcept(std::is_nothrow_copy_constructible_v<callables> &&
+             std::is_nothrow_constructible_v<std::tuple<Args...>, As&&...>)
+    : callables(fs), args(std::forward<As>(as)...) {}
+protected:
+    template <bool, typename, typename>
+    static constexpr bool reduces = false;
+    template <typename, typename>
+    static constexpr bool counts = false;
+    template <typename>
+    static constexpr bool finds = false;
+    template <typename>
+    static constexpr bool orders = false;
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f) const
+    {
+        return std::apply([&](const Fs& ... fs) {
+            return std::forward<F>(f)(bound<Fs, Args...>{fs, args}...);
+        }, static_cast<const callables&>(*this));
+    }
+    constexpr const callables& functions() const { return *this; }
+    constexpr const std::tuple<Args...>& arguments() const { return args; }
+private:
+    std::tuple<Args...> args;
+};
+
+// The result of memoized calls to a quantifier of callables. Each callable
+// is called when its result is first needed, so the short circuiting of
+// the logical operators is kept, and at most once.
+template <typename Args, typename ... Fs>
+class memo_storage;
+template <typename ... Args, typename ... Fs>
+class memo_storage<std::tuple<Args...>, Fs...> : public bound_storage<std::tuple<Args...>, Fs...>
+{
+    using base = bound_storage<std::tuple<Args...>, Fs...>;
+public:
+    using base::base;
+protected:
+    using base::reduces;
+    using base::counts;
+    using base::finds;
+    using base::orders;
+    template <typename F>
+    decltype(auto) apply(F&& f) const
+    {
+        return apply_indexed(std::forward<F>(f), std::index_sequence_for<Fs...>{});
+    }
+private:
+    template <typename F, std::size_t ... I>
+    decltype(auto) apply_indexed(F&& f, std::index_sequence<I...>) const
+    {
+        return std::forward<F>(f)(memo_bound<Fs, Args...>{std::get<I>(this->functions()),
+                                                          this->arguments(),
+                                                          std::get<I>(results)}...);
+    }
+    mutable std::tuple<std::optional<typename memo_bound<Fs, Args...>::RT>...> results;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,4346 @@
+#ifndef DRY_COMPARISONS_CORE_HPP_
+#define DRY_COMPARISONS_CORE_HPP_
+
+#include <utility>
+#include <type_traits>
+#include <array>
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <memory>
+#include <string_view>
+#if defined(__cpp_impl_three_way_comparison) && __has_include(<compare>)
+#include <compare>
+#endif
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#if __cplusplus > 201703L && __has_include(<source_location>)
+#include <source_location>
+#endif
+#endif
+
+namespace rollbear {
+
+template <typename ... T>
+class any_of;
+template <typename ... T>
+class all_of;
+template <typename ... T>
+class none_of;
+template <typename ... T>
+class adaptive_any_of;
+template <typename T, typename S = T>
+class any_of_range;
+template <typename T, typename S = T>
+class all_of_range;
+template <typename T, typename S = T>
+class none_of_range;
+template <std::size_t Min, std::size_t Max, typename ... T>
+class count_of;
+
+// The index of the first member of a quantifier that is true, and its
+// value, as given by which(). If no member is true, index is the number of
+// members, and value is value initialized.
+template <typename R>
+struct first_match
+{
+    std::size_t index;
+    R value;
+};
+
+namespace internal {
+
+// A quantifier compared with another is the outer one, i.e. the left
+// operand, so the reversed operators of the quantifiers step aside when
+// the other operand is a quantifier too.
+template <typename T>
+constexpr bool is_quantifier_v = false;
+template <typename ... T>
+constexpr bool is_quantifier_v<any_of<T...>> = true;
+template <typename ... T>
+constexpr bool is_quantifier_v<all_of<T...>> = true;
+template <typename ... T>
+constexpr bool is_quantifier_v<none_of<T...>> = true;
+template <typename ... T>
+constexpr bool is_quantifier_v<adaptive_any_of<T...>> = true;
+template <typename T, typename S>
+constexpr bool is_quantifier_v<any_of_range<T, S>> = true;
+template <typename T, typename S>
+constexpr bool is_quantifier_v<all_of_range<T, S>> = true;
+template <typename T, typename S>
+constexpr bool is_quantifier_v<none_of_range<T, S>> = true;
+template <std::size_t Min, std::size_t Max, typename ... T>
+constexpr bool is_quantifier_v<count_of<Min, Max, T...>> = true;
+
+enum class quantifier { any, all, none };
+
+// Whether some member compared less than, equivalent to, greater than, or
+// unordered with, a value.
+struct orderings
+{
+    bool less;
+    bool equivalent;
+    bool greater;
+    bool unordered;
+};
+
+}
+
+#if defined(__cpp_lib_three_way_comparison)
+namespace internal {
+// Only a literal 0 converts to this, as for the std orderings.
+struct literal_zero
+{
+    consteval literal_zero(literal_zero*) noexcept {}
+};
+}
+
+// The result of q <=> u, or u <=> q, for a quantifier q, with each member
+// compared with u once. less, equivalent, greater and unordered tell whether some member
+// compared so. Compared with 0, it gives what comparing q with u gives,
+// e.g. (q <=> u) < 0 is q < u, and (q <=> u) == 0 is q == u.
+template <internal::quantifier Q>
+struct ordering_summary : internal::orderings
+{
+    friend constexpr bool operator==(const ordering_summary& s, internal::literal_zero) noexcept
+    {
+        return s.holds(false, true, false);
+    }
+    friend constexpr bool operator<(const ordering_summary& s, internal::literal_zero) noexcept
+    {
+        return s.holds(true, false, false);
+    }
+    friend constexpr bool operator<=(const ordering_summary& s, internal::literal_zero) noexcept
+    {
+        return s.holds(true, true, false);
+    }
+    friend constexpr bool operator>(const ordering_summary& s, internal::literal_zero) noexcept
+    {
+        return s.holds(false, false, true);
+    }
+    friend constexpr bool operator>=(const ordering_summary& s, internal::literal_zero) noexcept
+    {
+        return s.holds(false, true, true);
+    }
+    friend constexpr bool operator<(internal::literal_zero, const ordering_summary& s) noexcept
+    {
+        return s > 0;
+    }
+    friend constexpr bool operator<=(internal::literal_zero, const ordering_summary& s) noexcept
+    {
+        return s >= 0;
+    }
+    friend constexpr bool operator>(internal::literal_zero, const ordering_summary& s) noexcept
+    {
+        return s < 0;
+    }
+    friend constexpr bool operator>=(internal::literal_zero, const ordering_summary& s) noexcept
+    {
+        return s <= 0;
+    }
+    // u <=> q is rewritten as 0 <=> (q <=> u), which is the summary with
+    // less and greater swapped.
+    friend constexpr ordering_summary operator<=>(internal::literal_zero, const ordering_summary& s) noexcept
+    {
+        return {{s.greater, s.equivalent, s.less, s.unordered}};
+    }
+private:
+    // Whether the quantifier holds, for a comparison that holds for the
+    // members ordered less (l), equivalent (e) or greater (g).
+    constexpr bool holds(bool l, bool e, bool g) const noexcept
+    {
+        const bool some = (l && less) || (e && equivalent) || (g && greater);
+        const bool other = (!l && less) || (!e && equivalent) || (!g && greater) || unordered;
+        if constexpr (Q == internal::quantifier::any)
+            return some;
+        else if constexpr (Q == internal::quantifier::all)
+            return !other;
+        else
+            return !some;
+    }
+};
+
+namespace internal {
+// The summary of q <=> u, for a quantifier Q of members of type T..., if
+// each of them can be compared with u with <=>.
+template <quantifier Q, typename U, typename ... T>
+using summary_t = decltype((void(std::declval<const T&>() <=> std::declval<const U&>()), ...),
+                           ordering_summary<Q>());
+
+// Adds how the comparison category value c orders to r.
+template <typename C>
+constexpr void add_ordering(orderings& r, C c) noexcept
+{
+    const bool l = c < 0;
+    const bool e = c == 0;
+    const bool g = c > 0;
+    r.less |= l;
+    r.equivalent |= e;
+    r.greater |= g;
+    r.unordered |= !(l || e || g);
+}
+}
+#endif
+
+// Whether an end of an interval belongs to it.
+enum class endpoint { closed, open };
+
+// The values from lo to hi. A value compares equal to an interval when it
+// lies within it, so that e.g. x == any_of(between(1, 5), between(100, 200))
+// tests whether x lies in either interval.
+template <typename T, endpoint Lo = endpoint::closed, endpoint Hi = endpoint::closed>
+struct interval
+{
+    using value_type = T;
+    static constexpr endpoint lower = Lo;
+    static constexpr endpoint upper = Hi;
+
+    T lo;
+    T hi;
+
+    template <typename U>
+    constexpr auto contains(const U& u) const
+    noexcept(noexcept(bool(lo <= u), bool(lo < u), bool(u <= hi), bool(u < hi)))
+    -> decltype(bool(lo <= u), bool(lo < u), bool(u <= hi), bool(u < hi), bool())
+    {
+        // Spelled with <= rather than !(<), so that NaN lies in no interval.
+        const bool above = Lo == endpoint::closed ? bool(lo <= u) : bool(lo < u);
+        const bool below = Hi == endpoint::closed ? bool(u <= hi) : bool(u < hi);
+        return above && below;
+    }
+    constexpr bool empty() const noexcept(noexcept(bool(lo <= hi), bool(lo < hi)))
+    {
+        return Lo == endpoint::closed && Hi == endpoint::closed ? !bool(lo <= hi) : !bool(lo < hi);
+    }
+
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator==(const interval& i, const U& u)
+    noexcept(noexcept(i.contains(u)))
+    -> decltype(i.contains(u))
+    {
+        return i.contains(u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator==(const U& u, const interval& i)
+    noexcept(noexcept(i.contains(u)))
+    -> decltype(i.contains(u))
+    {
+        return i.contains(u);
+    }
+#endif
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const interval& i, const U& u)
+    noexcept(noexcept(i.contains(u)))
+    -> decltype(i.contains(u))
+    {
+        return !i.contains(u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const interval& i)
+    noexcept(noexcept(i.contains(u)))
+    -> decltype(i.contains(u))
+    {
+        return !i.contains(u);
+    }
+};
+
+// [lo, hi]
+template <typename L, typename H>
+constexpr interval<std::common_type_t<L, H>> between(const L& lo, const H& hi)
+{
+    using T = std::common_type_t<L, H>;
+    return {static_cast<T>(lo), static_cast<T>(hi)};
+}
+// [lo, hi)
+template <typename L, typename H>
+constexpr interval<std::common_type_t<L, H>, endpoint::closed, endpoint::open> half_open(const L& lo, const H& hi)
+{
+    using T = std::common_type_t<L, H>;
+    return {static_cast<T>(lo), static_cast<T>(hi)};
+}
+// (lo, hi)
+template <typename L, typename H>
+constexpr interval<std::common_type_t<L, H>, endpoint::open, endpoint::open> strictly_between(const L& lo, const H& hi)
+{
+    using T = std::common_type_t<L, H>;
+    return {static_cast<T>(lo), static_cast<T>(hi)};
+}
+
+// Where the text of a text_pattern must be found in a string.
+enum class text_position { prefix, suffix, anywhere };
+
+// A string compares equal to a text_pattern when it starts with, ends with,
+// or contains, its text, so that e.g. path == any_of(starts_with("/api/"),
+// starts_with("/v2/")) tests whether path starts with either. The text is
+// referred to, not copied.
+struct text_pattern
+{
+    std::string_view text;
+    text_position position;
+
+    constexpr bool matches(std::string_view s) const noexcept
+    {
+        if (s.size() < text.size()) return false;
+        switch (position)
+        {
+        case text_position::prefix:
+            return std::string_view(s.data(), text.size()) == text;
+        case text_position::suffix:
+            return std::string_view(s.data() + (s.size() - text.size()), text.size()) == text;
+        default:
+            return s.find(text) != std::string_view::npos;
+        }
+    }
+
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator==(const text_pattern& p, const U& u)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return p.matches(u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator==(const U& u, const text_pattern& p)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return p.matches(u);
+    }
+#endif
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator!=(const text_pattern& p, const U& u)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return !p.matches(u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator!=(const U& u, const text_pattern& p)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return !p.matches(u);
+    }
+};
+
+constexpr text_pattern starts_with(std::string_view text) noexcept
+{
+    return {text, text_position::prefix};
+}
+constexpr text_pattern ends_with(std::string_view text) noexcept
+{
+    return {text, text_position::suffix};
+}
+constexpr text_pattern contains(std::string_view text) noexcept
+{
+    return {text, text_position::anywhere};
+}
+
+namespace internal {
+constexpr char fold_case(char c) noexcept
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+}
+
+// A string compares equal to an icase_string when it has the same text,
+// with ASCII letters compared regardless of case, so that e.g.
+// name == any_of(icase("content-type"), icase("content-length")) tests
+// a header name without lower casing a copy of it first. The text is
+// referred to, not copied.
+struct icase_string
+{
+    std::string_view text;
+
+    constexpr bool matches(std::string_view s) const noexcept
+    {
+        if (s.size() != text.size()) return false;
+        for (std::size_t i = 0; i != s.size(); ++i)
+        {
+            if (internal::fold_case(s[i]) != internal::fold_case(text[i])) return false;
+        }
+        return true;
+    }
+
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator==(const icase_string& p, const U& u)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return p.matches(u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator==(const U& u, const icase_string& p)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return p.matches(u);
+    }
+#endif
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator!=(const icase_string& p, const U& u)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return !p.matches(u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U> &&
+                                                      std::is_convertible_v<const U&, std::string_view>>>
+    friend constexpr bool operator!=(const U& u, const icase_string& p)
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        return !p.matches(u);
+    }
+};
+
+constexpr icase_string icase(std::string_view text) noexcept
+{
+    return {text};
+}
+
+namespace internal {
+
+// Named, and inline, like the other constants below, so that it can be
+// used from a module interface unit.
+struct commutative_eq_t {
+    struct A {
+        [[maybe_unused]] constexpr bool operator==(int) const { return false; }
+    };
+    template <typename T>
+    [[maybe_unused]] static constexpr auto func(T* t) -> decltype(0 == *t) {
+        return true;
+    }
+    template <typename>
+    [[maybe_unused]] static constexpr auto func(...) -> bool { return false;}
+    [[maybe_unused]] constexpr operator bool() const { return func<A>(nullptr);}
+};
+inline constexpr commutative_eq_t commutative_eq{};
+
+template <bool>
+struct eq_type
+{
+    template <typename A, typename B>
+    using type = decltype(std::declval<const A&>() == std::declval<B&>());
+};
+template <>
+struct eq_type<false> {};
+
+template <bool b, typename A, typename B>
+using eq_type_t = typename eq_type<!commutative_eq && b>::template type<A,B>;
+
+// A callable bound to the arguments of a call, and the same, but with the
+// result of the first call kept. Defined in dry-comparisons-bind.hpp.
+template <typename F, typename ... Args>
+struct bound;
+template <typename F, typename ... Args>
+struct memo_bound;
+
+struct eq
+{
+    template <typename A, typename B>
+    constexpr auto operator()(A&& a, B&& b) const noexcept(noexcept(a == b)) -> decltype(a == b) { return a == b; }
+};
+struct ne
+{
+    template <typename A, typename B>
+    constexpr auto operator()(A&& a, B&& b) const noexcept(noexcept(a != b)) -> decltype(a != b) { return a != b; }
+};
+struct lt
+{
+    template <typename A, typename B>
+    constexpr auto operator()(A&& a, B&& b) const noexcept(noexcept(a < b)) -> decltype(a < b) { return a < b; }
+};
+struct le
+{
+    template <typename A, typename B>
+    constexpr auto operator()(A&& a, B&& b) const noexcept(noexcept(a <= b)) -> decltype(a <= b) { return a <= b; }
+};
+struct gt
+{
+    template <typename A, typename B>
+    constexpr auto operator()(A&& a, B&& b) const noexcept(noexcept(a > b)) -> decltype(a > b) { return a > b; }
+};
+struct ge
+{
+    template <typename A, typename B>
+    constexpr auto operator()(A&& a, B&& b) const noexcept(noexcept(a >= b)) -> decltype(a >= b) { return a >= b; }
+};
+
+template <typename Op>
+constexpr bool is_relop_v = std::is_same_v<Op, eq> || std::is_same_v<Op, ne> ||
+                            std::is_same_v<Op, lt> || std::is_same_v<Op, le> ||
+                            std::is_same_v<Op, gt> || std::is_same_v<Op, ge>;
+
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#elif defined(__clang__) && __clang_major__ >= 9 || defined(__GNUC__) && __GNUC__ >= 9 || defined(_MSC_VER) && _MSC_VER >= 1925
+    return __builtin_is_constant_evaluated();
+#else
+    // Unknown, so assume the worst and always take the constexpr path.
+    return true;
+#endif
+}
+
+#ifndef DRY_COMPARISONS_ATOMIC_ORDER
+// The memory order of the load of a std::atomic that a quantifier is
+// compared with. It is loaded once, and every member is compared with the
+// value loaded, instead of with a load of its own.
+#define DRY_COMPARISONS_ATOMIC_ORDER std::memory_order_acquire
+#endif
+
+template <typename>
+constexpr bool is_atomic_v = false;
+template <typename T>
+constexpr bool is_atomic_v<std::atomic<T>> = true;
+
+template <typename T>
+T load_once(const std::atomic<T>& a) noexcept
+{
+    return a.load(DRY_COMPARISONS_ATOMIC_ORDER);
+}
+
+namespace simd {
+
+// Register width in bytes, picked at compile time from the target flags.
+// 0 means no vector kernel, and packs are tested with a plain loop instead.
+#if defined(__GNUC__) && defined(__AVX512F__)
+inline constexpr std::size_t width = 64;
+#elif defined(__GNUC__) && defined(__AVX2__)
+inline constexpr std::size_t width = 32;
+#elif defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+inline constexpr std::size_t width = 16;
+#else
+inline constexpr std::size_t width = 0;
+#endif
+
+template <std::size_t Size, bool Signed>
+struct int_lane;
+template <> struct int_lane<1, true> { using type = std::int8_t; };
+template <> struct int_lane<1, false> { using type = std::uint8_t; };
+template <> struct int_lane<2, true> { using type = std::int16_t; };
+template <> struct int_lane<2, false> { using type = std::uint16_t; };
+template <> struct int_lane<4, true> { using type = std::int32_t; };
+template <> struct int_lane<4, false> { using type = std::uint32_t; };
+template <> struct int_lane<8, true> { using type = std::int64_t; };
+template <> struct int_lane<8, false> { using type = std::uint64_t; };
+
+// The type a vector lane holds for an element of type T. Enums compare
+// as their underlying type, and bool (0 or 1) as an unsigned byte.
+template <typename T, typename = void>
+struct lane {};
+template <typename T>
+struct lane<T, std::enable_if_t<std::is_integral_v<T>>>
+{
+    using type = typename int_lane<sizeof(T), std::is_signed_v<T>>::type;
+};
+template <>
+struct lane<bool> { using type = std::uint8_t; };
+template <typename T>
+struct lane<T, std::enable_if_t<std::is_enum_v<T>>> : lane<std::underlying_type_t<T>> {};
+template <>
+struct lane<float> { using type = float; };
+template <>
+struct lane<double> { using type = double; };
+
+template <typename T, typename = void>
+constexpr bool vectorizable_v = false;
+template <typename T>
+constexpr bool vectorizable_v<T, std::void_t<typename lane<T>::type>> =
+    width > 0 && sizeof(typename lane<T>::type) == sizeof(T);
+
+#if defined(__GNUC__)
+template <typename L>
+struct vec
+{
+    typedef L type __attribute__((vector_size(width)));
+};
+
+// Loads a register with the elements at p, p + stride, p + 2 * stride and
+// so on, in bytes. Elements that lie next to each other are loaded at
+// once, and those of a member of an array of structs are gathered one lane
+// at a time.
+template <typename V, typename L>
+inline V load(const unsigned char* p, std::size_t stride) noexcept
+{
+    constexpr std::size_t lanes = width / sizeof(L);
+    V v;
+    if (stride == sizeof(L))
+    {
+        std::memcpy(&v, p, width);
+        return v;
+    }
+    L l[lanes];
+    for (std::size_t k = 0; k != lanes; ++k) std::memcpy(&l[k], p + k * stride, sizeof(L));
+    std::memcpy(&v, l, width);
+    return v;
+}
+
+// Returns true if op(e, u) holds for any of the n elements e of type T at
+// p, stride bytes apart, when All is false, or for every one when All is
+// true. Whole registers are compared at a time, and the lane masks are
+// only reduced once at the end.
+template <bool All, typename T, typename Op>
+inline bool reduce(Op op, const unsigned char* p, std::size_t n, const T& u, std::size_t stride) noexcept
+{
+    using L = typename lane<T>::type;
+    using V = typename vec<L>::type;
+    using M = decltype(op(V{}, V{}));
+    constexpr std::size_t lanes = width / sizeof(L);
+    L ul;
+    std::memcpy(&ul, &u, sizeof(L));
+    const V needle = V{} + ul;
+    M acc = All ? ~M{} : M{};
+    const std::size_t whole = n - n % lanes;
+    std::size_t i = 0;
+    for (; i != whole; i += lanes)
+    {
+        const V v = load<V, L>(p + i * stride, stride);
+        if constexpr (All) acc &= op(v, needle); else acc |= op(v, needle);
+    }
+    std::uint64_t words[width / sizeof(std::uint64_t)];
+    std::memcpy(words, &acc, width);
+    bool r = All;
+    for (auto w : words)
+    {
+        if constexpr (All) r &= (w == ~std::uint64_t{}); else r |= (w != 0);
+    }
+    for (; i < n; ++i)
+    {
+        L e;
+        std::memcpy(&e, p + i * stride, sizeof(L));
+        if constexpr (All) r &= bool(op(e, ul)); else r |= bool(op(e, ul));
+    }
+    return r;
+}
+template <bool All, typename T, typename Op>
+inline bool reduce(Op op, const T* p, std::size_t n, const T& u) noexcept
+{
+    return reduce<All>(op, reinterpret_cast<const unsigned char*>(p), n, u, sizeof(T));
+}
+
+// Returns the number of i for which op(p[i], u) holds, or, once that
+// reaches limit, some number no less than limit. The lane masks of each
+// register are counted with popcount.
+template <typename T, typename Op>
+inline std::size_t count(Op op, const T* p, std::size_t n, const T& u, std::size_t limit) noexcept
+{
+    using L = typename lane<T>::type;
+    using V = typename vec<L>::type;
+    constexpr std::size_t lanes = width / sizeof(L);
+    L ul;
+    std::memcpy(&ul, &u, sizeof(L));
+    const V needle = V{} + ul;
+    const std::size_t whole = n - n % lanes;
+    std::size_t c = 0;
+    std::size_t i = 0;
+    for (; i != whole && c < limit; i += lanes)
+    {
+        V v;
+        std::memcpy(&v, p + i, width);
+        const auto mask = op(v, needle);
+        std::uint64_t words[width / sizeof(std::uint64_t)];
+        std::memcpy(words, &mask, width);
+        std::size_t bits = 0;
+        for (auto w : words) bits += static_cast<std::size_t>(__builtin_popcountll(w));
+        c += bits / (8 * sizeof(L));
+    }
+    for (; i < n && c < limit; ++i)
+    {
+        L e;
+        std::memcpy(&e, p + i, sizeof(L));
+        c += bool(op(e, ul));
+    }
+    return c;
+}
+
+// Which orderings the n elements of type T at p, stride bytes apart, have
+// with u, in one pass over the registers, with the lane masks of <, == and
+// > each collected, and of none of them, for unordered floating point
+// lanes.
+template <typename T>
+inline orderings order(const unsigned char* p, std::size_t n, const T& u, std::size_t stride) noexcept
+{
+    using L = typename lane<T>::type;
+    using V = typename vec<L>::type;
+    using M = decltype(V{} < V{});
+    constexpr std::size_t lanes = width / sizeof(L);
+    L ul;
+    std::memcpy(&ul, &u, sizeof(L));
+    const V needle = V{} + ul;
+    M lt{}, eq{}, gt{}, un{};
+    const std::size_t whole = n - n % lanes;
+    std::size_t i = 0;
+    for (; i != whole; i += lanes)
+    {
+        const V v = load<V, L>(p + i * stride, stride);
+        const M l = v < needle;
+        const M e = v == needle;
+        const M g = v > needle;
+        lt |= l;
+        eq |= e;
+        gt |= g;
+        un |= ~(l | e | g);
+    }
+    auto some = [](const M& m) {
+        std::uint64_t words[width / sizeof(std::uint64_t)];
+        std::memcpy(words, &m, width);
+        bool r = false;
+        for (auto w : words) r |= (w != 0);
+        return r;
+    };
+    orderings r{some(lt), some(eq), some(gt), some(un)};
+    for (; i < n; ++i)
+    {
+        L e;
+        std::memcpy(&e, p + i * stride, sizeof(L));
+        r.less |= e < ul;
+        r.equivalent |= e == ul;
+        r.greater |= e > ul;
+        r.unordered |= !(e < ul || e == ul || e > ul);
+    }
+    return r;
+}
+template <typename T>
+inline orderings order(const T* p, std::size_t n, const T& u) noexcept
+{
+    return order(reinterpret_cast<const unsigned char*>(p), n, u, sizeof(T));
+}
+#endif
+}
+
+#ifndef DRY_COMPARISONS_FOLD_LIMIT
+// Packs with more members than this are not folded, where it can be
+// avoided, since folds are costly to compile, and compilers limit their
+// size, e.g. Clang to 256 members by default.
+#define DRY_COMPARISONS_FOLD_LIMIT 64
+#endif
+
+template <bool ...>
+struct bools {};
+// True iff all of B are. Unlike std::conjunction, it is not a template
+// recursion as deep as the pack.
+template <bool ... B>
+constexpr bool all_true_v = std::is_same_v<bools<true, B...>, bools<B..., true>>;
+
+// A member of a flat_tuple. Empty members take no space.
+template <std::size_t I, typename T, bool = std::is_empty_v<T> && !std::is_final_v<T>>
+class leaf
+{
+public:
+    template <typename U = T, typename = std::enable_if_t<std::is_default_constructible_v<U>>>
+    constexpr leaf() noexcept(std::is_nothrow_default_constructible_v<T>) : value() {}
+    template <typename U>
+    constexpr leaf(U&& u) noexcept(std::is_nothrow_constructible_v<T, U&&>) : value(std::forward<U>(u)) {}
+    constexpr const T& get() const noexcept { return value; }
+    constexpr T& get() noexcept { return value; }
+private:
+    T value;
+};
+template <std::size_t I, typename T>
+class leaf<I, T, true> : T
+{
+public:
+    template <typename U = T, typename = std::enable_if_t<std::is_default_constructible_v<U>>>
+    constexpr leaf() noexcept(std::is_nothrow_default_constructible_v<T>) : T() {}
+    template <typename U>
+    constexpr leaf(U&& u) noexcept(std::is_nothrow_constructible_v<T, U&&>) : T(std::forward<U>(u)) {}
+    constexpr const T& get() const noexcept { return *this; }
+    constexpr T& get() noexcept { return *this; }
+};
+
+// A tuple where every member is a direct base, named by its index, instead
+// of the chain of bases of std::tuple, as deep as the pack, that makes large
+// packs slow to compile, and hit the template recursion limit. It is an
+// aggregate, since naming each of N bases in a constructor costs the
+// compiler N^2.
+template <typename Indexes, typename ... Ts>
+struct flat_tuple;
+template <std::size_t ... I, typename ... Ts>
+struct flat_tuple<std::index_sequence<I...>, Ts...> : leaf<I, Ts>...
+{
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f) const
+    {
+        return std::forward<F>(f)(static_cast<const leaf<I, Ts>&>(*this).get()...);
+    }
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f)
+    {
+        return std::forward<F>(f)(static_cast<leaf<I, Ts>&>(*this).get()...);
+    }
+};
+
+template <typename R>
+constexpr bool builtin_logic_v = std::is_arithmetic_v<std::remove_cv_t<std::remove_reference_t<R>>> ||
+                                 std::is_pointer_v<std::remove_cv_t<std::remove_reference_t<R>>>;
+
+// (f(v) || ...) when Or, otherwise (f(v) && ...). When the pack is larger
+// than DRY_COMPARISONS_FOLD_LIMIT, and the results are arithmetic or
+// pointers, so that the built in operators are used, the members are
+// instead visited in a braced list, which is evaluated in order, and
+// short circuits the same way, but is flat, and cheap to compile.
+template <bool Or, typename F, typename ... V>
+constexpr auto fold(F& f, const V& ... v)
+{
+    if constexpr (sizeof...(V) > DRY_COMPARISONS_FOLD_LIMIT &&
+                  all_true_v<builtin_logic_v<decltype(f(v))>...>)
+    {
+        bool r = !Or;
+        const bool visited[] = {(r != Or ? (r = bool(f(v))) : r)...};
+        static_cast<void>(visited);
+        return r;
+    }
+    else if constexpr (Or)
+        return (f(v) || ...);
+    else
+        return (f(v) && ...);
+}
+
+// Calls f with each of v, in order.
+template <typename F, typename ... V>
+constexpr void each(F&& f, const V& ... v)
+{
+    const bool visited[] = {true, (static_cast<void>(f(v)), true)...};
+    static_cast<void>(visited);
+}
+
+// No upper limit for a count_of.
+inline constexpr std::size_t unbounded = ~std::size_t{};
+
+// Whether f(v) is true for at least Min, and at most Max, of v. The
+// members are visited in order, and only until the result is known, i.e.
+// when more than Max are true, or too few are left to reach Min, or when
+// Min are true and too few are left to exceed Max.
+template <std::size_t Min, std::size_t Max, typename F, typename ... V>
+constexpr bool count_in(F& f, const V& ... v)
+{
+    std::size_t hits = 0;
+    std::size_t left = sizeof...(V);
+    auto known = [&] { return hits > Max || hits + left < Min || (hits >= Min && hits + left <= Max); };
+    each([&](const auto& m) {
+        if (known()) return;
+        hits += bool(f(m));
+        --left;
+    }, v...);
+    return hits >= Min && hits <= Max;
+}
+
+template <typename Op, typename U, typename T>
+using op_result_t = decltype(std::declval<Op>()(std::declval<const T&>(), std::declval<const U&>()));
+
+// The type of (std::declval<R>() || ...) when Or, otherwise of
+// (std::declval<R>() && ...), and if it may throw. When all of R are
+// arithmetic types or pointers, which comparisons nearly always give, the
+// built in operators are used, and the answer is known without the fold,
+// which for large packs would be costly, or too large to compile.
+template <bool Builtin, bool Or, typename ... R>
+struct fold_result
+{
+    using type = bool;
+    static constexpr bool nothrow = true;
+};
+template <typename ... R>
+struct fold_result<false, true, R...>
+{
+    using type = decltype((std::declval<R>() || ...));
+    static constexpr bool nothrow = noexcept((std::declval<R>() || ...));
+};
+template <typename ... R>
+struct fold_result<false, false, R...>
+{
+    using type = decltype((std::declval<R>() && ...));
+    static constexpr bool nothrow = noexcept((std::declval<R>() && ...));
+};
+template <bool Or, typename ... R>
+using fold_result_of = fold_result<all_true_v<builtin_logic_v<R>...>, Or, R...>;
+
+// The type of (op(t, u) || ...) and (op(t, u) && ...) for members t of the
+// types T, and if they may throw.
+template <typename Op, typename U, typename ... T>
+using or_result_t = typename fold_result_of<true, op_result_t<Op, U, T>...>::type;
+template <typename Op, typename U, typename ... T>
+using and_result_t = typename fold_result_of<false, op_result_t<Op, U, T>...>::type;
+template <typename Op, typename U, typename ... T>
+constexpr bool nothrow_or_v = all_true_v<noexcept(std::declval<Op>()(std::declval<const T&>(), std::declval<const U&>()))...> &&
+                              fold_result_of<true, op_result_t<Op, U, T>...>::nothrow;
+template <typename Op, typename U, typename ... T>
+constexpr bool nothrow_and_v = all_true_v<noexcept(std::declval<Op>()(std::declval<const T&>(), std::declval<const U&>()))...> &&
+                               fold_result_of<false, op_result_t<Op, U, T>...>::nothrow;
+
+// bool, if all op(t, u) for members t of the types T can be counted, and if
+// that may throw.
+template <typename Op, typename U, typename ... T>
+using count_result_t = std::enable_if_t<all_true_v<std::is_constructible_v<bool, op_result_t<Op, U, T>>...>, bool>;
+template <typename Op, typename U, typename ... T>
+constexpr bool nothrow_count_v = all_true_v<noexcept(bool(std::declval<Op>()(std::declval<const T&>(), std::declval<const U&>())))...>;
+
+// A storage exposes its members through apply(f), which calls f with all
+// members. A storage that knows a faster way than the member by member fold
+// to test op(member, u) for some member (All == false) or for every member
+// (All == true), says so with reduces<All, Op, U> and provides reduce<All>().
+// Likewise, one that can count the members for which op(member, u) holds
+// says so with counts<Op, U> and provides count(op, u, limit), which may
+// stop counting at limit, one that can find the first member equal to u
+// says so with finds<U> and provides find(u), and one that can tell in one
+// pass how its members order against u says so with orders<U> and provides
+// order(u).
+template <typename ... Ts>
+class tuple_storage
+{
+    using tuple = flat_tuple<std::index_sequence_for<Ts...>, Ts...>;
+public:
+    template <typename B = tuple, typename = std::enable_if_t<std::is_default_constructible_v<B>>>
+    constexpr tuple_storage()
+    noexcept(std::is_nothrow_default_constructible_v<tuple>)
+    : members() {}
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && sizeof...(Us) != 0 &&
+                                          all_true_v<std::is_constructible_v<Ts, Us&&>...>>>
+    constexpr tuple_storage(Us&& ... us)
+    noexcept(all_true_v<std::is_nothrow_constructible_v<Ts, Us&&>...>)
+    : members{std::forward<Us>(us)...} {}
+protected:
+    template <bool, typename, typename>
+    static constexpr bool reduces = false;
+    template <typename, typename>
+    static constexpr bool counts = false;
+    template <typename>
+    static constexpr bool finds = false;
+    template <typename>
+    static constexpr bool orders = false;
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f) const
+    {
+        return members.apply(std::forward<F>(f));
+    }
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f)
+    {
+        return members.apply(std::forward<F>(f));
+    }
+private:
+    // A member rather than a base, since a class with as many indirect
+    // bases as a large pack has is slow to compile.
+    tuple members;
+};
+
+// Homogeneous packs of values are stored as an array, so that for
+// arithmetic or enum values a comparison against a value of the same type
+// can be made one vector register at a time. The registers are loaded
+// unaligned, so the layout is the same whatever the target flags.
+template <typename T, std::size_t N>
+class array_storage
+{
+    static constexpr std::size_t bytes = sizeof(T) * N;
+public:
+    constexpr array_storage()
+    noexcept(std::is_nothrow_default_constructible_v<T>)
+    : values{} {}
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == N &&
+                                          all_true_v<std::is_constructible_v<T, Us&&>...>>>
+    constexpr array_storage(Us&& ... us)
+    noexcept(all_true_v<std::is_nothrow_constructible_v<T, Us&&>...>)
+    : values{static_cast<T>(std::forward<Us>(us))...} {}
+protected:
+    template <bool, typename Op, typename U>
+    static constexpr bool reduces = is_relop_v<Op> && std::is_same_v<U, T> &&
+                                    simd::vectorizable_v<T> && bytes >= simd::width;
+    template <bool All, typename Op, typename U>
+    constexpr bool reduce(Op op, const U& u) const noexcept
+    {
+#if defined(__GNUC__)
+        // When the members are known constants, e.g. in a temporary, the
+        // compiler folds the scalar comparisons better, often into a bit
+        // mask test.
+        bool known = false;
+        if constexpr (N <= DRY_COMPARISONS_FOLD_LIMIT)
+            known = apply([](const auto& ... v) { return (__builtin_constant_p(v) && ...); });
+        if (!is_constant_evaluated() && !known) return simd::reduce<All>(op, values, N, u);
+#endif
+        if constexpr (N > DRY_COMPARISONS_FOLD_LIMIT)
+        {
+            for (const auto& v : values)
+            {
+                if (bool(op(v, u)) != All) return !All;
+            }
+            return All;
+        }
+        else if constexpr (All)
+            return apply([&](const auto& ... v) { return (op(v, u) && ...);});
+        else
+            return apply([&](const auto& ... v) { return (op(v, u) || ...);});
+    }
+    template <typename Op, typename U>
+    static constexpr bool counts = reduces<false, Op, U>;
+    template <typename Op, typename U>
+    constexpr std::size_t count(Op op, const U& u, std::size_t limit) const noexcept
+    {
+#if defined(__GNUC__)
+        if (!is_constant_evaluated()) return simd::count(op, values, N, u, limit);
+#endif
+        std::size_t c = 0;
+        for (std::size_t i = 0; i != N && c < limit; ++i) c += bool(op(values[i], u));
+        return c;
+    }
+    template <typename>
+    static constexpr bool finds = false;
+    template <typename U>
+    static constexpr bool orders = reduces<false, lt, U>;
+    template <typename U>
+    constexpr orderings order(const U& u) const noexcept
+    {
+#if defined(__GNUC__)
+        if (!is_constant_evaluated()) return simd::order(values, N, u);
+#endif
+        orderings r{false, false, false, false};
+        for (const auto& v : values)
+        {
+            const bool l = v < u;
+            const bool e = v == u;
+            const bool g = v > u;
+            r.less |= l;
+            r.equivalent |= e;
+            r.greater |= g;
+            r.unordered |= !(l || e || g);
+        }
+        return r;
+    }
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f) const
+    {
+        return apply_indexed(std::forward<F>(f), values, std::make_index_sequence<N>{});
+    }
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f)
+    {
+        return apply_indexed(std::forward<F>(f), values, std::make_index_sequence<N>{});
+    }
+private:
+    template <typename F, typename V, std::size_t ... I>
+    static constexpr decltype(auto) apply_indexed(F&& f, V& v, std::index_sequence<I...>)
+    {
+        return std::forward<F>(f)(v[I]...);
+    }
+    T values[N];
+};
+
+// Homogeneous packs of lvalue references are stored as an array of
+// pointers.
+template <typename T, std::size_t N>
+class reference_storage
+{
+    using element = std::remove_reference_t<T>;
+public:
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == N &&
+                                          all_true_v<std::is_convertible_v<Us&&, T>...>>>
+    constexpr reference_storage(Us&& ... us) noexcept
+    : members{std::addressof(static_cast<T>(us))...} {}
+protected:
+    template <bool, typename, typename>
+    static constexpr bool reduces = false;
+    template <typename, typename>
+    static constexpr bool counts = false;
+    template <typename>
+    static constexpr bool finds = false;
+    template <typename>
+    static constexpr bool orders = false;
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f) const
+    {
+        return apply_indexed(std::forward<F>(f), std::make_index_sequence<N>{});
+    }
+private:
+    template <typename F, std::size_t ... I>
+    constexpr decltype(auto) apply_indexed(F&& f, std::index_sequence<I...>) const
+    {
+        return std::forward<F>(f)(*members[I]...);
+    }
+    element* members[N];
+};
+
+template <auto V>
+struct constant
+{
+    using value_type = decltype(V);
+    static constexpr value_type value = V;
+    constexpr operator value_type() const noexcept { return V; }
+};
+
+// The type of the value of a member, which for a bound callable is the
+// type it returns.
+template <typename T>
+struct value_of
+{
+    using type = std::decay_t<T>;
+};
+template <auto V>
+struct value_of<constant<V>>
+{
+    using type = decltype(V);
+};
+template <typename F, typename ... Args>
+struct value_of<bound<F, Args...>>
+{
+    using type = std::decay_t<std::invoke_result_t<const F&, const Args&...>>;
+};
+template <typename F, typename ... Args>
+struct value_of<memo_bound<F, Args...>> : value_of<bound<F, Args...>> {};
+template <typename T>
+using value_of_t = typename value_of<T>::type;
+
+// p applied to t, as with std::invoke(p, t), where p is a pointer to a data
+// member, a pointer to a member function with no parameters, or a
+// callable.
+template <typename M, typename C, typename T>
+constexpr auto project(M C::* p, const T& t) noexcept
+-> std::enable_if_t<std::is_object_v<M> && std::is_base_of_v<C, T>, const M&>
+{
+    return t.*p;
+}
+template <typename M, typename C, typename T>
+constexpr auto project(M C::* p, const T& t)
+-> std::enable_if_t<std::is_function_v<M> && std::is_base_of_v<C, T>, decltype((t.*p)())>
+{
+    return (t.*p)();
+}
+template <typename P, typename T, typename = std::enable_if_t<!std::is_member_pointer_v<P>>>
+constexpr auto project(const P& p, const T& t)
+-> decltype(p(t))
+{
+    return p(t);
+}
+
+// The member type of a quantifier of p applied to members of type T.
+// Results returned by lvalue reference, e.g. data members, are referred
+// to, and others are kept by value.
+template <typename P, typename T,
+          typename R = decltype(project(std::declval<const P&>(), std::declval<const T&>()))>
+using projection_t = std::conditional_t<std::is_lvalue_reference_v<R>, R, std::remove_cv_t<std::remove_reference_t<R>>>;
+
+// The comparisons that can be made on a set of compile time constants of
+// the same integral or enum type T, against a value of type T, without
+// looking at the constants one by one.
+#ifndef DRY_COMPARISONS_SEARCH_THRESHOLD
+// Sets of compile time constants with more distinct, sparse, values than
+// this are searched with a perfect hash, a comparison tree, or a sorted
+// array, instead of being compared one by one. See bench/constant_sets.cpp.
+#define DRY_COMPARISONS_SEARCH_THRESHOLD 4
+#endif
+
+template <typename T, T ... V>
+struct constant_set
+{
+    using L = typename simd::lane<T>::type;
+    using UL = std::make_unsigned_t<L>;
+    static constexpr std::size_t size = sizeof...(V);
+
+    struct sorted_values
+    {
+        L values[size];
+        std::size_t count;
+    };
+    static constexpr sorted_values sort_unique()
+    {
+        sorted_values r{{static_cast<L>(V)...}, size};
+        for (std::size_t i = 1; i < size; ++i)
+        {
+            for (std::size_t j = i; j > 0 && r.values[j] < r.values[j - 1]; --j)
+            {
+                auto t = r.values[j];
+                r.values[j] = r.values[j - 1];
+                r.values[j - 1] = t;
+            }
+        }
+        std::size_t n = 1;
+        for (std::size_t i = 1; i < size; ++i)
+        {
+            if (r.values[i] != r.values[n - 1]) r.values[n++] = r.values[i];
+        }
+        r.count = n;
+        return r;
+    }
+    static constexpr sorted_values sorted = sort_unique();
+    static constexpr L min = sorted.values[0];
+    static constexpr L max = sorted.values[sorted.count - 1];
+    static constexpr UL span = static_cast<UL>(static_cast<UL>(max) - static_cast<UL>(min));
+    static constexpr bool contiguous = span == sorted.count - 1;
+    static constexpr bool dense = span < 64;
+    static constexpr std::uint64_t mask = [] {
+        std::uint64_t m = 0;
+        for (std::size_t i = 0; i != sorted.count; ++i)
+        {
+            m |= std::uint64_t{1} << (static_cast<UL>(static_cast<UL>(sorted.values[i]) - static_cast<UL>(min)) & 63);
+        }
+        return m;
+    }();
+
+    static constexpr L lane_of(const T& t) noexcept { return static_cast<L>(t); }
+    static constexpr UL offset_of(L u) noexcept
+    {
+        return static_cast<UL>(static_cast<UL>(u) - static_cast<UL>(min));
+    }
+
+    static constexpr bool linear_search(L u) noexcept
+    {
+        return ((u == static_cast<L>(V)) || ...);
+    }
+
+    // The searches below also have variants that give the index of the
+    // first of V that equals u, or size if none does, for find_first().
+    using index_t = std::conditional_t<(size < 256), std::uint8_t, std::size_t>;
+    template <std::size_t N>
+    struct index_table
+    {
+        index_t values[N];
+    };
+    // The index of the first of V equal to each sorted value.
+    static constexpr index_table<size> first_indexes = [] {
+        index_table<size> r{};
+        const L v[] = {static_cast<L>(V)...};
+        for (std::size_t k = 0; k != sorted.count; ++k)
+        {
+            std::size_t i = 0;
+            while (v[i] != sorted.values[k]) ++i;
+            r.values[k] = static_cast<index_t>(i);
+        }
+        return r;
+    }();
+
+    static constexpr std::size_t linear_index(L u) noexcept
+    {
+        std::size_t i = 0;
+        static_cast<void>(((u == static_cast<L>(V) || (++i, false)) || ...));
+        return i;
+    }
+
+    template <std::size_t Lo = 0, std::size_t Hi = sorted.count>
+    static constexpr bool tree_search(L u) noexcept
+    {
+        if constexpr (Hi - Lo == 1)
+        {
+            return u == sorted.values[Lo];
+        }
+        else
+        {
+            constexpr std::size_t mid = Lo + (Hi - Lo) / 2;
+            if (u < sorted.values[mid]) return tree_search<Lo, mid>(u);
+            return tree_search<mid, Hi>(u);
+        }
+    }
+    template <std::size_t Lo = 0, std::size_t Hi = sorted.count>
+    static constexpr std::size_t tree_index(L u) noexcept
+    {
+        if constexpr (Hi - Lo == 1)
+        {
+            return u == sorted.values[Lo] ? first_indexes.values[Lo] : size;
+        }
+        else
+        {
+            constexpr std::size_t mid = Lo + (Hi - Lo) / 2;
+            if (u < sorted.values[mid]) return tree_index<Lo, mid>(u);
+            return tree_index<mid, Hi>(u);
+        }
+    }
+
+    // Binary search with a fixed number of steps, where each step is a
+    // conditional move rather than a branch.
+    static constexpr std::size_t sorted_position(L u) noexcept
+    {
+        std::size_t first = 0;
+        for (std::size_t n = sorted.count; n > 1; n -= n / 2)
+        {
+            first = sorted.values[first + n / 2] <= u ? first + n / 2 : first;
+        }
+        return first;
+    }
+    static constexpr bool sorted_search(L u) noexcept
+    {
+        return sorted.values[sorted_position(u)] == u;
+    }
+    static constexpr std::size_t sorted_index(L u) noexcept
+    {
+        const std::size_t k = sorted_position(u);
+        return sorted.values[k] == u ? first_indexes.values[k] : size;
+    }
+
+    static constexpr std::size_t table_capacity = [] {
+        std::size_t n = 2;
+        while (n < size) n *= 2;
+        return 4 * n;
+    }();
+    struct perfect_hash
+    {
+        std::uint64_t multiplier;
+        unsigned shift;
+        bool found;
+        L slots[table_capacity];
+    };
+    static constexpr std::size_t hash(L u, std::uint64_t multiplier, unsigned shift) noexcept
+    {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(static_cast<UL>(u)) * multiplier) >> shift);
+    }
+    // Searches for a multiplier that maps every value to its own slot in a
+    // table with 1, 2 or 4 times as many slots (rounded up to a power of 2)
+    // as there are values. Empty slots hold a value that hashes elsewhere,
+    // so that they never match.
+    static constexpr perfect_hash make_perfect_hash()
+    {
+        perfect_hash h{};
+        std::uint64_t seed = 0x9e3779b97f4a7c15U;
+        unsigned bits = 1;
+        while ((std::size_t{1} << bits) < sorted.count) ++bits;
+        for (std::size_t slots = std::size_t{1} << bits; slots <= table_capacity; slots *= 2, ++bits)
+        {
+            for (int attempt = 0; attempt != 64; ++attempt)
+            {
+                seed += 0x9e3779b97f4a7c15U;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9U;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebU;
+                const std::uint64_t multiplier = (z ^ (z >> 31)) | 1U;
+                const auto shift = 64 - bits;
+                bool used[table_capacity] = {};
+                bool collision = false;
+                for (std::size_t i = 0; i != sorted.count && !collision; ++i)
+                {
+                    const auto slot = hash(sorted.values[i], multiplier, shift);
+                    collision = used[slot];
+                    used[slot] = true;
+                }
+                if (!collision)
+                {
+                    h.multiplier = multiplier;
+                    h.shift = shift;
+                    h.found = true;
+                    for (std::size_t i = 0; i != slots; ++i) h.slots[i] = sorted.values[0];
+                    for (std::size_t i = 0; i != sorted.count; ++i)
+                    {
+                        h.slots[hash(sorted.values[i], multiplier, shift)] = sorted.values[i];
+                    }
+                    return h;
+                }
+            }
+        }
+        return h;
+    }
+    static constexpr bool large = sorted.count > DRY_COMPARISONS_SEARCH_THRESHOLD;
+    static constexpr perfect_hash table = large ? make_perfect_hash() : perfect_hash{};
+
+    static constexpr bool hash_search(L u) noexcept
+    {
+        return table.slots[hash(u, table.multiplier, table.shift)] == u;
+    }
+    static constexpr index_table<table_capacity> slot_indexes = [] {
+        index_table<table_capacity> r{};
+        for (auto& i : r.values) i = static_cast<index_t>(size);
+        for (std::size_t k = 0; k != sorted.count; ++k)
+        {
+            r.values[hash(sorted.values[k], table.multiplier, table.shift)] = first_indexes.values[k];
+        }
+        return r;
+    }();
+    static constexpr std::size_t hash_index(L u) noexcept
+    {
+        const auto slot = hash(u, table.multiplier, table.shift);
+        return table.slots[slot] == u ? slot_indexes.values[slot] : size;
+    }
+
+    // For dense sets, the index of the first of V at each offset from min,
+    // a table that a switch on find_first() can jump through directly.
+    static constexpr bool by_offset = contiguous || dense;
+    static constexpr index_table<by_offset ? span + 1 : 1> offset_indexes = [] {
+        index_table<by_offset ? span + 1 : 1> r{};
+        for (auto& i : r.values) i = static_cast<index_t>(size);
+        if constexpr (by_offset)
+        {
+            for (std::size_t k = 0; k != sorted.count; ++k)
+            {
+                r.values[offset_of(sorted.values[k])] = first_indexes.values[k];
+            }
+        }
+        return r;
+    }();
+
+    static constexpr std::size_t index_of(const T& t) noexcept
+    {
+        const L u = lane_of(t);
+        if constexpr (by_offset)
+        {
+            const auto offset = offset_of(u);
+            return offset <= span ? offset_indexes.values[offset] : size;
+        }
+        else if constexpr (!large)
+            return linear_index(u);
+        else if constexpr (table.found)
+            return hash_index(u);
+        else if constexpr (sorted.count <= 16)
+            return tree_index(u);
+        else
+            return sorted_index(u);
+    }
+
+    static constexpr bool contains(const T& t) noexcept
+    {
+        const L u = lane_of(t);
+        const auto offset = offset_of(u);
+        if constexpr (contiguous)
+            return offset <= span;
+        else if constexpr (dense)
+            return offset <= span && ((mask >> offset) & 1U);
+        else if constexpr (!large)
+            return linear_search(u);
+        else if constexpr (table.found)
+            return hash_search(u);
+        else if constexpr (sorted.count <= 16)
+            return tree_search(u);
+        else
+            return sorted_search(u);
+    }
+
+    template <bool All, typename Op>
+    static constexpr bool test(Op op, const T& t) noexcept
+    {
+        constexpr bool all_same = sorted.count == 1;
+        if constexpr (std::is_same_v<Op, eq>)
+            return All ? all_same && t == T(min) : contains(t);
+        else if constexpr (std::is_same_v<Op, ne>)
+            return All ? !contains(t) : !(all_same && t == T(min));
+        else if constexpr (All == (std::is_same_v<Op, lt> || std::is_same_v<Op, le>))
+            return op(T(max), t);
+        else
+            return op(T(min), t);
+    }
+};
+
+// Compile time constants are not stored at all. Comparisons against a value
+// of the same integral or enum type as all the constants are lowered to a
+// range check, a bit mask test, a balanced comparison tree, or for large
+// sets, a perfect hash or branch free binary search.
+template <bool, auto ... V>
+struct constant_set_for
+{
+    using type = void;
+};
+template <auto V, auto ... Vs>
+struct constant_set_for<true, V, Vs...>
+{
+    using type = constant_set<decltype(V), V, Vs...>;
+};
+
+template <auto ... V>
+class constant_storage
+{
+    using first = std::tuple_element_t<0, std::tuple<decltype(V)...>>;
+    static constexpr bool integral = all_true_v<std::is_same_v<first, decltype(V)>...> &&
+                                     (std::is_integral_v<first> || std::is_enum_v<first>);
+    using set = typename constant_set_for<integral, V...>::type;
+protected:
+    template <bool, typename Op, typename U>
+    static constexpr bool reduces = integral && is_relop_v<Op> && std::is_same_v<U, first>;
+    template <bool All, typename Op, typename U>
+    constexpr bool reduce(Op op, const U& u) const noexcept
+    {
+        return set::template test<All>(op, u);
+    }
+    template <typename, typename>
+    static constexpr bool counts = false;
+    template <typename U>
+    static constexpr bool finds = integral && std::is_same_v<U, first>;
+    template <typename U>
+    constexpr std::size_t find(const U& u) const noexcept
+    {
+        return set::index_of(u);
+    }
+    template <typename U>
+    static constexpr bool orders = integral && std::is_same_v<U, first>;
+    template <typename U>
+    constexpr orderings order(const U& u) const noexcept
+    {
+        return {set::template test<false>(lt{}, u), set::template test<false>(eq{}, u),
+                set::template test<false>(gt{}, u), false};
+    }
+    template <typename F>
+    constexpr decltype(auto) apply(F&& f) const
+    {
+        return std::forward<F>(f)(constant<V>{}...);
+    }
+};
+
+template <typename T>
+constexpr bool is_string_member_v = std::is_same_v<T, std::string_view>;
+template <std::size_t N>
+constexpr bool is_string_member_v<const char(&)[N]> = true;
+
+template <typename U>
+constexpr bool is_string_like_v = std::is_convertible_v<const U&, std::string_view> &&
+                                  !std::is_pointer_v<std::decay_t<U>> &&
+                                  !std::is_array_v<U>;
+
+// Compares n bytes with as few loads as possible. Strings of 4 to 16 bytes
+// are compared with two, possibly overlapping, 4 or 8 byte loads from each.
+inline bool equal_bytes(const char* a, const char* b, std::size_t n) noexcept
+{
+    if (n >= 8)
+    {
+        if (n > 16) return std::memcmp(a, b, n) == 0;
+        std::uint64_t a1, a2, b1, b2;
+        std::memcpy(&a1, a, 8);
+        std::memcpy(&a2, a + n - 8, 8);
+        std::memcpy(&b1, b, 8);
+        std::memcpy(&b2, b + n - 8, 8);
+        return ((a1 ^ b1) | (a2 ^ b2)) == 0;
+    }
+    if (n >= 4)
+    {
+        std::uint32_t a1, a2, b1, b2;
+        std::memcpy(&a1, a, 4);
+        std::memcpy(&a2, a + n - 4, 4);
+        std::memcpy(&b1, b, 4);
+        std::memcpy(&b2, b + n - 4, 4);
+        return ((a1 ^ b1) | (a2 ^ b2)) == 0;
+    }
+    return n == 0 || (a[0] == b[0] && a[n / 2] == b[n / 2] && a[n - 1] == b[n - 1]);
+}
+
+// Packs of string literals (const char(&)[N]) and std::string_views keep
+// the members as they are, but also record the length of each, and which
+// lengths and first characters occur. Testing a std::string or
+// std::string_view for equality then rejects most strings with one or two
+// bit tests, and only compares the bytes of members of the right length,
+// with word sized loads. Comparisons with a const char* are unaffected,
+// and still compare pointers.
+template <typename ... Ts>
+class string_storage : public tuple_storage<Ts...>
+{
+    using base = tuple_storage<Ts...>;
+public:
+    template <typename B = base, typename = std::enable_if_t<std::is_default_constructible_v<B>>>
+    constexpr string_storage() noexcept : base() {}
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) &&
+                                          std::is_constructible_v<base, Us&&...>>>
+    constexpr string_storage(Us&& ... us)
+    noexcept(std::is_nothrow_constructible_v<base, Us&&...>)
+    : base(std::forward<Us>(us)...)
+    {
+        std::size_t i = 0;
+        this->apply([&](const auto& ... m) {
+            each([&](const auto& v) { views[i++] = std::string_view(v); }, m...);
+        });
+        record(std::index_sequence_for<Ts...>{});
+    }
+protected:
+    using base::apply;
+    template <bool, typename Op, typename U>
+    static constexpr bool reduces = (std::is_same_v<Op, eq> || std::is_same_v<Op, ne>) &&
+                                    is_string_like_v<U>;
+    template <bool All, typename Op, typename U>
+    constexpr bool reduce(Op, const U& u) const noexcept
+    {
+        const std::string_view s(u);
+        if constexpr (All == std::is_same_v<Op, ne>)
+        {
+            return All != contains(s);
+        }
+        else
+        {
+            // all_of == and any_of != both ask if some member differs
+            for (auto v : views)
+            {
+                if (v != s) return !All;
+            }
+            return All;
+        }
+    }
+private:
+    constexpr bool contains(std::string_view s) const noexcept
+    {
+        // Few members are cheaper to compare than the masks are to test.
+        if constexpr (sizeof...(Ts) <= DRY_COMPARISONS_SEARCH_THRESHOLD)
+        {
+            return matches_any(s, std::index_sequence_for<Ts...>{});
+        }
+        const auto n = s.size();
+        if (!((lengths >> (n < 63 ? n : 63)) & 1U)) return false;
+        if (n != 0)
+        {
+            const auto c = static_cast<unsigned char>(s[0]);
+            if (!((first_chars[c / 64] >> (c % 64)) & 1U)) return false;
+        }
+        return matches_any(s, std::index_sequence_for<Ts...>{});
+    }
+    // The members are visited with folds rather than loops, so that when
+    // the object is a temporary, the compiler can compute the masks and
+    // unroll the comparisons, like for a hand written chain. Packs too
+    // large to fold are visited with loops.
+    static constexpr bool loop = sizeof...(Ts) > DRY_COMPARISONS_FOLD_LIMIT;
+    template <std::size_t ... I>
+    constexpr void record(std::index_sequence<I...>) noexcept
+    {
+        if constexpr (loop)
+        {
+            for (auto v : views) record(v);
+        }
+        else
+        {
+            (record(views[I]), ...);
+        }
+    }
+    constexpr void record(std::string_view v) noexcept
+    {
+        lengths |= std::uint64_t{1} << (v.size() < 63 ? v.size() : 63);
+        if (!v.empty()) mark_first_char(static_cast<unsigned char>(v[0]));
+    }
+    constexpr void mark_first_char(unsigned char c) noexcept
+    {
+        first_chars[c / 64] |= std::uint64_t{1} << (c % 64);
+    }
+    template <std::size_t ... I>
+    constexpr bool matches_any(std::string_view s, std::index_sequence<I...>) const noexcept
+    {
+        const auto n = s.size();
+        if constexpr (loop)
+        {
+            for (auto v : views)
+            {
+                if (is_constant_evaluated() ? v == s : v.size() == n && equal_bytes(v.data(), s.data(), n)) return true;
+            }
+            return false;
+        }
+        else
+        {
+            if (is_constant_evaluated()) return ((views[I] == s) || ...);
+            return ((views[I].size() == n && equal_bytes(views[I].data(), s.data(), n)) || ...);
+        }
+    }
+    std::string_view views[sizeof...(Ts)] = {};
+    std::uint64_t lengths = 0;
+    std::uint64_t first_chars[4] = {};
+};
+
+#ifndef DRY_COMPARISONS_ICASE_LENGTH
+// The longest text of an icase_string that is kept lower cased by the
+// storage of its pack.
+#define DRY_COMPARISONS_ICASE_LENGTH 32
+#endif
+
+// Lower cases the ASCII letters of the n bytes at p, 16 at a time. n is a
+// multiple of 16.
+inline void fold_case(char* p, std::size_t n) noexcept
+{
+#if defined(__GNUC__)
+    typedef unsigned char bytes __attribute__((vector_size(16)));
+    for (std::size_t i = 0; i != n; i += sizeof(bytes))
+    {
+        bytes v;
+        std::memcpy(&v, p + i, sizeof(bytes));
+        const bytes upper = (bytes)(static_cast<bytes>(v - 'A') < 26);
+        v |= upper & 0x20;
+        std::memcpy(p + i, &v, sizeof(bytes));
+    }
+#else
+    for (std::size_t i = 0; i != n; ++i) p[i] = fold_case(p[i]);
+#endif
+}
+
+// Homogeneous packs of icase_strings keep the texts lower cased, and,
+// like string_storage, which lengths and lower cased first characters
+// occur. Testing a string then rejects most strings with one or two bit
+// tests, lower cases the string once, into a buffer on the stack, and
+// compares the bytes of members of the right length, with word sized
+// loads. Members longer than DRY_COMPARISONS_ICASE_LENGTH, and strings
+// that long, are compared one character at a time.
+template <std::size_t N>
+class icase_storage : public array_storage<icase_string, N>
+{
+    using base = array_storage<icase_string, N>;
+    static constexpr std::size_t size = (DRY_COMPARISONS_ICASE_LENGTH + 15) / 16 * 16;
+public:
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == N &&
+                                          std::is_constructible_v<base, Us&&...>>>
+    constexpr icase_storage(Us&& ... us)
+    noexcept(std::is_nothrow_constructible_v<base, Us&&...>)
+    : base(std::forward<Us>(us)...)
+    {
+        std::size_t i = 0;
+        apply([&](const auto& ... m) {
+            each([&](const icase_string& v) { record(i++, v.text); }, m...);
+        });
+    }
+protected:
+    using base::apply;
+    template <bool, typename Op, typename U>
+    static constexpr bool reduces = (std::is_same_v<Op, eq> || std::is_same_v<Op, ne>) &&
+                                    std::is_convertible_v<const U&, std::string_view>;
+    template <bool All, typename Op, typename U>
+    constexpr bool reduce(Op, const U& u) const
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        const std::string_view s(u);
+        if constexpr (All == std::is_same_v<Op, ne>)
+        {
+            return All != contains(s);
+        }
+        else
+        {
+            // all_of == and any_of != both ask if every member matches
+            auto match = [&](const icase_string& m) { return m.matches(s); };
+            return All == apply([&](const auto& ... v) { return fold<false>(match, v...); });
+        }
+    }
+private:
+    constexpr bool contains(std::string_view s) const noexcept
+    {
+        const auto n = s.size();
+        if (!((lengths >> (n < 63 ? n : 63)) & 1U)) return false;
+        if (n != 0)
+        {
+            const auto c = static_cast<unsigned char>(fold_case(s[0]));
+            if (!((first_chars[c / 64] >> (c % 64)) & 1U)) return false;
+        }
+        if (is_constant_evaluated() || n > DRY_COMPARISONS_ICASE_LENGTH)
+        {
+            auto match = [&](const icase_string& m) { return m.matches(s); };
+            return apply([&](const auto& ... v) { return fold<true>(match, v...); });
+        }
+        char folded[size] = {};
+        std::memcpy(folded, s.data(), n);
+        fold_case(folded, size);
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            if (sizes[i] == n && equal_bytes(texts[i], folded, n)) return true;
+        }
+        return false;
+    }
+    constexpr void record(std::size_t i, std::string_view v) noexcept
+    {
+        sizes[i] = v.size();
+        lengths |= std::uint64_t{1} << (v.size() < 63 ? v.size() : 63);
+        if (!v.empty())
+        {
+            const auto c = static_cast<unsigned char>(fold_case(v[0]));
+            first_chars[c / 64] |= std::uint64_t{1} << (c % 64);
+        }
+        if (v.size() > DRY_COMPARISONS_ICASE_LENGTH) return;
+        for (std::size_t k = 0; k != v.size(); ++k) texts[i][k] = fold_case(v[k]);
+    }
+    char texts[N][size] = {};
+    std::size_t sizes[N] = {};
+    std::uint64_t lengths = 0;
+    std::uint64_t first_chars[4] = {};
+};
+
+template <typename T>
+constexpr bool is_interval_v = false;
+template <typename T, endpoint Lo, endpoint Hi>
+constexpr bool is_interval_v<interval<T, Lo, Hi>> = true;
+
+// Homogeneous packs of more than DRY_COMPARISONS_SEARCH_THRESHOLD intervals
+// also keep the disjoint intervals that their union is made of, sorted,
+// which are computed when the object is created. Whether a value lies in
+// some member, for any_of == and none_of ==, or in no member, for
+// any_of != and all_of !=, is then found with a branch free binary search
+// over the lower ends, and one interval test, instead of two comparisons
+// per member.
+template <typename I, std::size_t N>
+class interval_storage : public array_storage<I, N>
+{
+    using base = array_storage<I, N>;
+    static constexpr bool nothrow_merge = std::is_nothrow_copy_assignable_v<I> &&
+                                          noexcept(std::declval<const I&>().empty());
+public:
+    constexpr interval_storage()
+    noexcept(std::is_nothrow_default_constructible_v<base> && nothrow_merge)
+    : base()
+    {
+        merge();
+    }
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == N &&
+                                          std::is_constructible_v<base, Us&&...>>>
+    constexpr interval_storage(Us&& ... us)
+    noexcept(std::is_nothrow_constructible_v<base, Us&&...> && nothrow_merge)
+    : base(std::forward<Us>(us)...)
+    {
+        merge();
+    }
+protected:
+    using base::apply;
+    template <bool All, typename Op, typename U>
+    static constexpr bool reduces = std::is_same_v<Op, std::conditional_t<All, ne, eq>>;
+    template <bool All, typename Op, typename U>
+    constexpr bool reduce(Op, const U& u) const noexcept(noexcept(std::declval<const I&>().contains(u)))
+    {
+        return contains(u) != All;
+    }
+private:
+    template <typename U>
+    constexpr bool contains(const U& u) const noexcept(noexcept(std::declval<const I&>().contains(u)))
+    {
+        std::size_t k = 0;
+        for (std::size_t n = count; n > 1; n -= n / 2)
+        {
+            k = merged[k + n / 2].lo <= u ? k + n / 2 : k;
+        }
+        return count != 0 && merged[k].contains(u);
+    }
+    constexpr void merge()
+    {
+        this->apply([this](const auto& ... m) {
+            each([this](const I& i) { if (!i.empty()) insert(i); }, m...);
+        });
+        if (count == 0) return;
+        std::size_t n = 1;
+        for (std::size_t k = 1; k != count; ++k)
+        {
+            if (joins(merged[n - 1], merged[k]))
+            {
+                if (merged[n - 1].hi < merged[k].hi) merged[n - 1].hi = merged[k].hi;
+            }
+            else
+            {
+                merged[n++] = merged[k];
+            }
+        }
+        count = n;
+    }
+    // Sorted by the lower ends.
+    constexpr void insert(const I& i)
+    {
+        std::size_t k = count++;
+        for (; k > 0 && i.lo < merged[k - 1].lo; --k)
+        {
+            merged[k] = merged[k - 1];
+        }
+        merged[k] = i;
+    }
+    // Whether a and b, with a.lo <= b.lo, have a union that is an
+    // interval. When they only touch, the shared end must belong to one.
+    static constexpr bool joins(const I& a, const I& b)
+    {
+        if constexpr (I::lower == endpoint::open && I::upper == endpoint::open)
+            return b.lo < a.hi;
+        else
+            return !(a.hi < b.lo);
+    }
+    I merged[N] = {};
+    std::size_t count = 0;
+};
+
+#ifndef DRY_COMPARISONS_PATTERN_LENGTH
+// The longest text of a pattern that is searched for with the automaton of
+// its pack. The automaton has room for this many characters per pattern.
+#define DRY_COMPARISONS_PATTERN_LENGTH 32
+#endif
+
+// Homogeneous packs of more than DRY_COMPARISONS_SEARCH_THRESHOLD text
+// patterns also keep an Aho-Corasick automaton of their texts, which is
+// built when the object is created, i.e. at compile time for a constexpr
+// object. Whether a string matches some member, for any_of == and
+// none_of ==, or no member, for any_of != and all_of !=, is then found in
+// one scan of the string, instead of one per member. Prefixes only match
+// in states as deep as the scan, and suffixes only in the state at the
+// end. The scan stops after the longest prefix if there are only
+// prefixes, and starts at the longest suffix from the end if there are
+// only suffixes. If some text is longer than
+// DRY_COMPARISONS_PATTERN_LENGTH, the members are compared one by one.
+template <std::size_t N>
+class pattern_storage : public array_storage<text_pattern, N>
+{
+    using base = array_storage<text_pattern, N>;
+    static constexpr std::size_t capacity = N * DRY_COMPARISONS_PATTERN_LENGTH + 1;
+    using index = std::conditional_t<(capacity < 0xffff), std::uint16_t, std::uint32_t>;
+    static constexpr index none = static_cast<index>(~index{});
+    static constexpr std::uint8_t prefix_end = 1;
+    static constexpr std::uint8_t suffix_end = 2;
+    static constexpr std::uint8_t anywhere_end = 4;
+public:
+    constexpr pattern_storage() noexcept
+    : base()
+    {
+        build();
+    }
+    template <typename ... Us,
+              typename = std::enable_if_t<sizeof...(Us) == N &&
+                                          std::is_constructible_v<base, Us&&...>>>
+    constexpr pattern_storage(Us&& ... us)
+    noexcept(std::is_nothrow_constructible_v<base, Us&&...>)
+    : base(std::forward<Us>(us)...)
+    {
+        build();
+    }
+protected:
+    using base::apply;
+    template <bool All, typename Op, typename U>
+    static constexpr bool reduces = std::is_same_v<Op, std::conditional_t<All, ne, eq>> &&
+                                    std::is_convertible_v<const U&, std::string_view>;
+    template <bool All, typename Op, typename U>
+    constexpr bool reduce(Op op, const U& u) const
+    noexcept(noexcept(std::string_view(std::declval<const U&>())))
+    {
+        if (!built)
+        {
+            auto compare = [&](const text_pattern& p) { return op(p, u); };
+            return apply([&](const auto& ... v) { return fold<!All>(compare, v...); });
+        }
+        return search(u) != All;
+    }
+private:
+    struct state
+    {
+        index child = none;
+        index sibling = none;
+        index fail = 0;
+        index depth = 0;
+        char byte = 0;
+        std::uint8_t ends = 0;
+    };
+    constexpr bool search(std::string_view s) const noexcept
+    {
+        if (always) return true;
+        const std::size_t n = s.size();
+        const std::size_t first = anywhere || longest_prefix != 0 || n < longest_suffix ? 0 : n - longest_suffix;
+        const std::size_t last = anywhere || longest_suffix != 0 || n < longest_prefix ? n : longest_prefix;
+        index q = 0;
+        for (std::size_t i = first; i != last; ++i)
+        {
+            q = next(q, s[i]);
+            const state& t = states[q];
+            if ((t.ends & anywhere_end) || ((t.ends & prefix_end) && t.depth == i + 1)) return true;
+        }
+        return (states[q].ends & suffix_end) && last == n;
+    }
+    constexpr index child_of(index q, char c) const noexcept
+    {
+        for (index k = states[q].child; k != none; k = states[k].sibling)
+        {
+            if (states[k].byte == c) return k;
+        }
+        return none;
+    }
+    // The state after c in state q, following the failure links.
+    constexpr index next(index q, char c) const noexcept
+    {
+        for (;;)
+        {
+            const index k = child_of(q, c);
+            if (k != none) return k;
+            if (q == 0) return 0;
+            q = states[q].fail;
+        }
+    }
+    constexpr void build() noexcept
+    {
+        apply([this](const auto& ... v) {
+            each([this](const text_pattern& p) { insert(p); }, v...);
+        });
+        if (!built) return;
+        // Breadth first, so that the failure state of each state, which is
+        // shallower, is linked before it.
+        index queue[capacity] = {};
+        std::size_t head = 0;
+        std::size_t tail = 0;
+        for (index k = states[0].child; k != none; k = states[k].sibling) queue[tail++] = k;
+        while (head != tail)
+        {
+            const index q = queue[head++];
+            for (index k = states[q].child; k != none; k = states[k].sibling)
+            {
+                if (q != 0) states[k].fail = next(states[q].fail, states[k].byte);
+                states[k].ends |= states[states[k].fail].ends & (suffix_end | anywhere_end);
+                queue[tail++] = k;
+            }
+        }
+    }
+    constexpr void insert(const text_pattern& p) noexcept
+    {
+        const std::size_t size = p.text.size();
+        if (size > DRY_COMPARISONS_PATTERN_LENGTH) built = false;
+        if (!built) return;
+        if (size == 0)
+        {
+            always = true;
+            return;
+        }
+        index q = 0;
+        for (char c : p.text)
+        {
+            index k = child_of(q, c);
+            if (k == none)
+            {
+                k = count++;
+                states[k].byte = c;
+                states[k].depth = static_cast<index>(states[q].depth + 1);
+                states[k].sibling = states[q].child;
+                states[q].child = k;
+            }
+            q = k;
+        }
+        if (p.position == text_position::prefix)
+        {
+            states[q].ends |= prefix_end;
+            if (longest_prefix < size) longest_prefix = size;
+        }
+        else if (p.position == text_position::suffix)
+        {
+            states[q].ends |= suffix_end;
+            if (longest_suffix < size) longest_suffix = size;
+        }
+        else
+        {
+            states[q].ends |= anywhere_end;
+            anywhere = true;
+        }
+    }
+    state states[capacity] = {};
+    index count = 1;
+    std::size_t longest_prefix = 0;
+    std::size_t longest_suffix = 0;
+    bool anywhere = false;
+    bool always = false;
+    bool built = true;
+};
+
+// The storage of the result of calling a quantifier of callables, and of
+// memoized calls. Defined in dry-comparisons-bind.hpp.
+template <typename Args, typename ... Fs>
+class bound_storage;
+template <typename Args, typename ... Fs>
+class memo_storage;
+
+template <typename ... Ts>
+struct storage
+{
+    using type = tuple_storage<Ts...>;
+};
+template <typename T, typename ... Ts>
+struct homogeneous_storage
+{
+    using type = std::conditional_t<std::is_lvalue_reference_v<T>,
+                                    reference_storage<T, sizeof...(Ts) + 1>,
+                 std::conditional_t<is_interval_v<T> && sizeof...(Ts) >= DRY_COMPARISONS_SEARCH_THRESHOLD,
+                                    interval_storage<T, sizeof...(Ts) + 1>,
+                 std::conditional_t<std::is_same_v<T, text_pattern> && sizeof...(Ts) >= DRY_COMPARISONS_SEARCH_THRESHOLD,
+                                    pattern_storage<sizeof...(Ts) + 1>,
+                 std::conditional_t<std::is_same_v<T, icase_string>,
+                                    icase_storage<sizeof...(Ts) + 1>,
+                 std::conditional_t<std::is_object_v<T> && !std::is_array_v<T> && !std::is_empty_v<T>,
+                                    array_storage<T, sizeof...(Ts) + 1>,
+                                    tuple_storage<T, Ts...>>>>>>;
+};
+// Packs of strings first, since string literals of the same length are
+// references to arrays of the same type.
+template <typename T, typename ... Ts>
+struct storage<T, Ts...>
+{
+    using type = std::conditional_t<is_string_member_v<T> && all_true_v<is_string_member_v<Ts>...>,
+                                    string_storage<T, Ts...>,
+                 std::conditional_t<sizeof...(Ts) != 0 && all_true_v<std::is_same_v<T, Ts>...>,
+                                    typename homogeneous_storage<T, Ts...>::type,
+                                    tuple_storage<T, Ts...>>>;
+};
+template <typename F, typename ... Fs, typename ... Args>
+struct storage<bound<F, Args...>, bound<Fs, Args...>...>
+{
+    using type = bound_storage<std::tuple<Args...>, F, Fs...>;
+};
+template <typename F, typename ... Fs, typename ... Args>
+struct storage<memo_bound<F, Args...>, memo_bound<Fs, Args...>...>
+{
+    using type = memo_storage<std::tuple<Args...>, F, Fs...>;
+};
+template <auto V, auto ... Vs>
+struct storage<constant<V>, constant<Vs>...>
+{
+    using type = constant_storage<V, Vs...>;
+};
+template <typename ... Ts>
+using storage_t = typename storage<Ts...>::type;
+
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+// Where a quantifier was created. Comparisons and conversions to bool are
+// counted per call site.
+struct call_site
+{
+    const char* file = "?";
+    unsigned line = 0;
+};
+
+// A value of type T, and the call site where it was passed. Used as the
+// type of the first constructor parameter of the quantifiers, so that the
+// default arguments are evaluated where the quantifier is created.
+template <typename T>
+struct located
+{
+#if defined(__cpp_lib_source_location)
+    template <typename V, typename = std::enable_if_t<std::is_constructible_v<T, V&&>>>
+    constexpr located(V&& v, std::source_location l = std::source_location::current())
+    : value(std::forward<V>(v)), site{l.file_name(), static_cast<unsigned>(l.line())} {}
+#else
+    template <typename V, typename = std::enable_if_t<std::is_constructible_v<T, V&&>>>
+    constexpr located(V&& v, const char* file = __builtin_FILE(), unsigned line = __builtin_LINE())
+    : value(std::forward<V>(v)), site{file, line} {}
+#endif
+    T value;
+    call_site site;
+};
+
+namespace instrumentation {
+
+// The index of the member deciding a result is counted up to this.
+inline constexpr std::size_t max_members = 64;
+
+struct counters
+{
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> comparisons{0};
+    std::atomic<std::uint64_t> decided_by[max_members] = {};
+};
+
+struct site_hash
+{
+    std::size_t operator()(const std::pair<const char*, unsigned>& k) const noexcept
+    {
+        return std::hash<const void*>{}(k.first) ^ (std::size_t{k.second} * 0x9e3779b97f4a7c15U);
+    }
+};
+
+// The counters of one thread. Only the owning thread writes to the
+// counters, so they are updated with relaxed atomic additions, without
+// locks. The mutex only guards adding call sites, against dump().
+struct shard
+{
+    std::mutex mutex;
+    std::unordered_map<std::pair<const char*, unsigned>, std::unique_ptr<counters>, site_hash> sites;
+};
+
+struct registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<shard>> shards;
+    // The number of comparisons not counted, see record().
+    std::atomic<std::uint64_t> dropped{0};
+
+    static registry& instance()
+    {
+        static registry r;
+        return r;
+    }
+};
+
+inline shard& this_thread_shard()
+{
+    // Shards are owned by the registry, and outlive their threads, so that
+    // nothing counted is lost.
+    thread_local shard* s = [] {
+        auto& r = registry::instance();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.shards.push_back(std::make_unique<shard>());
+        return r.shards.back().get();
+    }();
+    return *s;
+}
+
+inline void record(const call_site& site, std::size_t comparisons, std::size_t decider) noexcept
+{
+    const auto relaxed = std::memory_order_relaxed;
+    counters* found = nullptr;
+    // The first comparison at a call site, and the first of a thread,
+    // allocate. If that fails, the comparison is not counted, rather than
+    // terminating the program from inside it, and is counted as dropped
+    // instead. It is tried again at the next comparison.
+    try
+    {
+        auto& s = this_thread_shard();
+        const auto key = std::make_pair(site.file, site.line);
+        auto i = s.sites.find(key);
+        if (i == s.sites.end())
+        {
+            auto added = std::make_unique<counters>();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            i = s.sites.emplace(key, std::move(added)).first;
+        }
+        found = i->second.get();
+    }
+    catch (...)
+    {
+        registry::instance().dropped.fetch_add(1, relaxed);
+        return;
+    }
+    auto& c = *found;
+    c.calls.fetch_add(1, relaxed);
+    c.comparisons.fetch_add(comparisons, relaxed);
+    if (decider != 0) c.decided_by[(decider < max_members ? decider : max_members) - 1].fetch_add(1, relaxed);
+}
+
+}
+#endif
+
+// Gives the free functions of the library access to the members of the
+// quantifiers.
+struct access
+{
+    template <typename Q, typename F>
+    static constexpr decltype(auto) apply(const Q& q, F&& f)
+    {
+        return q.apply(std::forward<F>(f));
+    }
+    template <typename Q, typename F>
+    static constexpr decltype(auto) apply(Q& q, F&& f)
+    {
+        return q.apply(std::forward<F>(f));
+    }
+    // The elements of an any_of_range, all_of_range or none_of_range.
+    template <typename Q>
+    static constexpr auto elements(const Q& q) noexcept
+    {
+        return q.elements();
+    }
+    template <typename Q>
+    static constexpr bool ordered(const Q& q) noexcept
+    {
+        return q.ordered();
+    }
+};
+
+#ifndef DRY_COMPARISONS_SET_THRESHOLD
+// A quantifier of strings compared with an any_of or a none_of of strings
+// with more pairs of members than this is compared by looking up the
+// members of one side in a hash table of the other, instead of comparing
+// every pair. See bench/sets.cpp.
+#define DRY_COMPARISONS_SET_THRESHOLD 1024
+#endif
+
+template <typename ... T>
+struct members {};
+
+// An any_of or a none_of, of members or of a range, compared with each
+// member of another quantifier. size is 0 for ranges.
+template <typename U>
+struct set_of {};
+template <typename ... X>
+struct set_of<any_of<X...>>
+{
+    static constexpr bool none = false;
+    static constexpr std::size_t size = sizeof...(X);
+    using type = members<X...>;
+};
+template <typename ... X>
+struct set_of<none_of<X...>>
+{
+    static constexpr bool none = true;
+    static constexpr std::size_t size = sizeof...(X);
+    using type = members<X...>;
+};
+template <typename T, typename S>
+struct set_of<any_of_range<T, S>>
+{
+    static constexpr bool none = false;
+    static constexpr std::size_t size = 0;
+    static constexpr bool contiguous = std::is_same_v<T, S>;
+    using type = members<T>;
+};
+template <typename T, typename S>
+struct set_of<none_of_range<T, S>>
+{
+    static constexpr bool none = true;
+    static constexpr std::size_t size = 0;
+    static constexpr bool contiguous = std::is_same_v<T, S>;
+    using type = members<T>;
+};
+
+template <typename T>
+using plain_t = std::remove_cv_t<std::remove_reference_t<T>>;
+template <typename T>
+constexpr bool is_string_class_v = std::is_class_v<plain_t<T>> &&
+                                   std::is_convertible_v<const plain_t<T>&, std::string_view>;
+template <typename T>
+constexpr bool is_string_key_v = is_string_class_v<T> ||
+                                 (std::is_array_v<plain_t<T>> && std::is_same_v<std::remove_extent_t<plain_t<T>>, char>);
+
+// Strings are compared as sets when all members of one side are
+// std::string or std::string_view, so that every pair compares the
+// characters, and not the addresses, of string literals. Integral and enum
+// members are not, since comparing each member with a whole vector
+// register of the other side at a time is faster for all sizes measured.
+template <typename V, typename X>
+constexpr bool string_sets_v = false;
+template <typename ... V, typename ... X>
+constexpr bool string_sets_v<members<V...>, members<X...>>
+    = sizeof...(V) != 0 && sizeof...(X) != 0 &&
+      all_true_v<is_string_key_v<V>..., is_string_key_v<X>...> &&
+      (all_true_v<is_string_class_v<V>...> || all_true_v<is_string_class_v<X>...>);
+
+template <typename Op, typename U, typename V, typename = void>
+constexpr bool set_search_v = false;
+template <typename Op, typename U, typename ... V>
+constexpr bool set_search_v<Op, U, members<V...>, std::void_t<typename set_of<U>::type>>
+    = string_sets_v<members<V...>, typename set_of<U>::type> &&
+      (std::is_same_v<Op, eq> || std::is_same_v<Op, ne>) &&
+      (set_of<U>::size == 0 || sizeof...(V) * set_of<U>::size > DRY_COMPARISONS_SET_THRESHOLD);
+
+inline std::uint64_t mix(std::uint64_t k) noexcept
+{
+    k *= 0x9e3779b97f4a7c15U;
+    return k ^ (k >> 29);
+}
+// Hashes the length, and the first and last 8 bytes, so that it costs the
+// same for all lengths.
+inline std::uint64_t hash_key(std::string_view s) noexcept
+{
+    const char* p = s.data();
+    const auto n = s.size();
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (n >= 8)
+    {
+        std::memcpy(&a, p, 8);
+        std::memcpy(&b, p + n - 8, 8);
+    }
+    else if (n >= 4)
+    {
+        std::uint32_t a4, b4;
+        std::memcpy(&a4, p, 4);
+        std::memcpy(&b4, p + n - 4, 4);
+        a = a4;
+        b = b4;
+    }
+    else if (n != 0)
+    {
+        a = static_cast<unsigned char>(p[0]) | std::uint64_t{static_cast<unsigned char>(p[n / 2])} << 8;
+        b = static_cast<unsigned char>(p[n - 1]);
+    }
+    return mix(a ^ mix(b + n));
+}
+
+// An open addressing hash set of at most N strings, at most half full,
+// that needs no allocation.
+template <std::size_t N>
+class key_table
+{
+    static constexpr std::size_t bits = [] {
+        std::size_t b = 1;
+        while ((std::size_t{1} << b) < 2 * N) ++b;
+        return b;
+    }();
+    static constexpr std::size_t size = std::size_t{1} << bits;
+public:
+    static constexpr std::size_t absent = size;
+    // The slot of k, which is added if it is not there.
+    std::size_t insert(std::string_view k) noexcept
+    {
+        std::size_t i = slot(k);
+        for (; used[i]; i = (i + 1) % size)
+        {
+            if (keys[i] == k) return i;
+        }
+        used[i] = true;
+        keys[i] = k;
+        ++count;
+        return i;
+    }
+    std::size_t find(std::string_view k) const noexcept
+    {
+        for (std::size_t i = slot(k); used[i]; i = (i + 1) % size)
+        {
+            if (keys[i] == k) return i;
+        }
+        return absent;
+    }
+    // The number of distinct keys.
+    std::size_t count = 0;
+private:
+    static std::size_t slot(std::string_view k) noexcept
+    {
+        return static_cast<std::size_t>(hash_key(k) >> (64 - bits));
+    }
+    std::string_view keys[size] = {};
+    bool used[size] = {};
+};
+
+// Whether some (All == false), or every (All == true), one of the keys p
+// is among the m elements e. The keys are put in a table that is searched
+// for each element.
+template <bool All, std::size_t N, typename E>
+bool find_keys_among(const std::string_view (&p)[N], const E* e, std::size_t m) noexcept
+{
+    key_table<N> table;
+    for (const auto& k : p) table.insert(k);
+    bool found[key_table<N>::absent] = {};
+    std::size_t missing = table.count;
+    for (std::size_t j = 0; j != m; ++j)
+    {
+        const std::size_t i = table.find(std::string_view(e[j]));
+        if (i == table.absent) continue;
+        if constexpr (!All) return true;
+        if (!found[i])
+        {
+            found[i] = true;
+            if (--missing == 0) return true;
+        }
+    }
+    return false;
+}
+
+// Whether some (All == false), or every (All == true), one of the n keys p
+// is among the keys e. The keys e are put in a table that is searched for
+// each key p.
+template <bool All, std::size_t M>
+bool find_keys_in(const std::string_view* p, std::size_t n, const std::string_view (&e)[M]) noexcept
+{
+    key_table<M> table;
+    for (const auto& k : e) table.insert(k);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        if ((table.find(p[i]) != table.absent) != All) return !All;
+    }
+    return All;
+}
+
+// op(v, u), where u is an any_of or a none_of, is whether v is among the
+// members of u, or whether it is not. So a quantifier of the members v is
+// compared with u by looking up the members of the larger side in a hash
+// table of the members of the smaller, instead of comparing every pair.
+template <bool Or, typename Op, typename U, typename ... V>
+constexpr bool set_compare(Op op, const U& u, const V& ... v)
+{
+    using K = std::string_view;
+    auto compare = [&](const auto& m) { return op(m, u); };
+    if (is_constant_evaluated()) return fold<Or>(compare, v...);
+    // v == any_of(x...) and v != none_of(x...) ask if v is among x...
+    constexpr bool among = std::is_same_v<Op, eq> != set_of<U>::none;
+    // and for an any_of of v..., if some v is, or if not every v is.
+    constexpr bool every = Or != among;
+    const K p[sizeof...(V)] = {K(v)...};
+    bool r = false;
+    if constexpr (set_of<U>::size == 0)
+    {
+        // Sorted ranges are searched for each member anyway, and the
+        // elements of a range of data members are not next to each other.
+        if constexpr (!set_of<U>::contiguous)
+        {
+            return fold<Or>(compare, v...);
+        }
+        else
+        {
+            const auto e = access::elements(u);
+            if (access::ordered(u) || sizeof...(V) * e.count <= DRY_COMPARISONS_SET_THRESHOLD)
+                return fold<Or>(compare, v...);
+            r = find_keys_among<every>(p, e.first, e.count);
+        }
+    }
+    else
+    {
+        K e[set_of<U>::size] = {};
+        access::apply(u, [&](const auto& ... x) {
+            std::size_t i = 0;
+            each([&](const auto& m) { e[i++] = K(m); }, x...);
+        });
+        if constexpr (sizeof...(V) <= set_of<U>::size)
+            r = find_keys_among<every>(p, e, set_of<U>::size);
+        else
+            r = find_keys_in<every>(p, sizeof...(V), e);
+    }
+    return r == among;
+}
+
+template <typename ... Ts>
+class logical_tuple : storage_t<Ts...>
+{
+    using base = storage_t<Ts...>;
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+    using first_t = std::tuple_element_t<0, std::tuple<Ts...>>;
+public:
+    template <typename B = base, typename = std::enable_if_t<std::is_default_constructible_v<B>>>
+    constexpr logical_tuple() : base() {}
+    template <typename ... Us, typename = std::enable_if_t<std::is_constructible_v<base, first_t&&, Us&&...>>>
+    constexpr logical_tuple(located<first_t> first, Us&& ... us)
+    : base(std::forward<first_t>(first.value), std::forward<Us>(us)...), site(first.site) {}
+    template <typename ... Us, typename = std::enable_if_t<std::is_constructible_v<base, Us&&...>>>
+    constexpr logical_tuple(call_site site_, Us&& ... us)
+    : base(std::forward<Us>(us)...), site(site_) {}
+protected:
+    template <bool Or, typename F>
+    constexpr auto counted(F&& f) const
+    {
+        return this->apply([&](const auto& ... v) {
+            std::size_t n = 0;
+            auto call = [&](const auto& x) -> decltype(auto) { ++n; return f(x); };
+            auto r = fold<Or>(call, v...);
+            if (!is_constant_evaluated())
+            {
+                std::size_t decider = 0;
+                if constexpr (std::is_same_v<decltype(r), bool>) decider = r == Or ? n : 0;
+                instrumentation::record(site, n, decider);
+            }
+            return r;
+        });
+    }
+    template <typename F>
+    constexpr auto or_all(F&& f) const
+    {
+        return counted<true>(f);
+    }
+    template <typename F>
+    constexpr auto and_all(F&& f) const
+    {
+        return counted<false>(f);
+    }
+    // All comparisons are made one member at a time, to count them.
+    template <typename Op, typename U>
+    constexpr auto or_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return or_all(op, load_once(u));
+        else
+            return or_all([&](auto&& v) { return op(v, u);});
+    }
+    template <typename Op, typename U>
+    constexpr auto and_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return and_all(op, load_once(u));
+        else
+            return and_all([&](auto&& v) { return op(v, u);});
+    }
+    template <std::size_t Min, std::size_t Max, typename F>
+    constexpr bool count_all(F&& f) const
+    {
+        return this->apply([&](const auto& ... v) {
+            std::size_t n = 0;
+            auto call = [&](const auto& x) -> decltype(auto) { ++n; return f(x); };
+            const bool r = count_in<Min, Max>(call, v...);
+            if (!is_constant_evaluated()) instrumentation::record(site, n, n < sizeof...(v) ? n : 0);
+            return r;
+        });
+    }
+    template <std::size_t Min, std::size_t Max, typename Op, typename U>
+    constexpr bool count_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return count_all<Min, Max>(op, load_once(u));
+        else
+            return count_all<Min, Max>([&](auto&& v) { return op(v, u);});
+    }
+    template <typename RT, typename ... Args>
+    constexpr RT bind(Args&& ... args) const {
+
+        return this->apply([&](auto&& ... f) {
+            return RT(site, std::forward_as_tuple(f...), std::forward<Args>(args)...); });
+    }
+    template <typename RT, typename P>
+    constexpr RT project_all(const P& p) const
+    {
+        return this->apply([&](const auto& ... v) { return RT(site, project(p, v)...); });
+    }
+    call_site site;
+#else
+protected:
+    using base::base;
+#endif
+protected:
+    using base::apply;
+#if !defined(DRY_COMPARISONS_INSTRUMENT)
+    template <typename F>
+    constexpr auto or_all(F&& f) const
+    {
+        return this->apply([&](const auto& ... v) { return fold<true>(f, v...);});
+    }
+    template <typename F>
+    constexpr auto and_all(F&& f) const
+    {
+        return this->apply([&](const auto& ... v) { return fold<false>(f, v...);});
+    }
+    template <typename Op, typename U>
+    constexpr auto or_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return or_all(op, load_once(u));
+        else if constexpr (base::template reduces<false, Op, U>)
+            return this->template reduce<false>(op, u);
+        else if constexpr (set_search_v<Op, U, members<Ts...>>)
+            return this->apply([&](const auto& ... v) { return set_compare<true>(op, u, v...); });
+        else
+            return or_all([&](auto&& v) { return op(v, u);});
+    }
+    template <typename Op, typename U>
+    constexpr auto and_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return and_all(op, load_once(u));
+        else if constexpr (base::template reduces<true, Op, U>)
+            return this->template reduce<true>(op, u);
+        else if constexpr (set_search_v<Op, U, members<Ts...>>)
+            return this->apply([&](const auto& ... v) { return set_compare<false>(op, u, v...); });
+        else
+            return and_all([&](auto&& v) { return op(v, u);});
+    }
+    // Whether op(member, u) holds for at least Min, and at most Max, of the
+    // members.
+    template <std::size_t Min, std::size_t Max, typename F>
+    constexpr bool count_all(F&& f) const
+    {
+        return this->apply([&](const auto& ... v) { return count_in<Min, Max>(f, v...);});
+    }
+    template <std::size_t Min, std::size_t Max, typename Op, typename U>
+    constexpr bool count_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return count_all<Min, Max>(op, load_once(u));
+        else if constexpr (base::template counts<Op, U>)
+        {
+            const std::size_t c = this->count(op, u, Max == unbounded ? Min : Max + 1);
+            return c >= Min && c <= Max;
+        }
+        else
+            return count_all<Min, Max>([&](auto&& v) { return op(v, u);});
+    }
+    template <typename RT, typename ... Args>
+    constexpr RT bind(Args&& ... args) const {
+
+        return this->apply([&](auto&& ... f) {
+            return RT(std::forward_as_tuple(f...), std::forward<Args>(args)...); });
+    }
+    template <typename RT, typename P>
+    constexpr RT project_all(const P& p) const
+    {
+        return this->apply([&](const auto& ... v) { return RT(project(p, v)...); });
+    }
+#endif
+public:
+    // The index of the first member that equals u, or the number of
+    // members if none does, e.g. to switch on after a comparison, without
+    // comparing again.
+    template <typename U>
+    constexpr auto find_first(const U& u) const
+    -> decltype(std::declval<or_result_t<eq, U, Ts...>>(), std::size_t())
+    {
+        if constexpr (is_atomic_v<U>)
+            return find_first(load_once(u));
+#if !defined(DRY_COMPARISONS_INSTRUMENT)
+        else if constexpr (base::template finds<U>)
+            return this->find(u);
+#endif
+        else
+        {
+            std::size_t i = 0;
+            or_all([&](auto&& v) { return bool(eq{}(v, u)) || (++i, false); });
+            return i;
+        }
+    }
+    // The index and value of the first member that is true, e.g. of the
+    // first callable of a called quantifier that returns a true result.
+    template <typename C = std::common_type<value_of_t<Ts>...>>
+    constexpr auto which() const
+    -> std::enable_if_t<std::is_constructible_v<bool, typename C::type>, first_match<typename C::type>>
+    {
+        using R = typename C::type;
+        first_match<R> r{0, R()};
+        or_all([&](auto&& v) {
+            R x = v;
+            if (!bool(x)) return ++r.index, false;
+            r.value = std::move(x);
+            return true;
+        });
+        return r;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+protected:
+    // How the members order against u, each compared with u once.
+    template <typename U>
+    constexpr orderings order_all(const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return order_all(load_once(u));
+#if !defined(DRY_COMPARISONS_INSTRUMENT)
+        else if constexpr (base::template orders<U>)
+            return this->order(u);
+#endif
+        else
+        {
+            orderings r{false, false, false, false};
+            this->apply([&](const auto& ... v) {
+                each([&](const auto& m) { add_ordering(r, m <=> u); }, v...);
+            });
+            return r;
+        }
+    }
+#endif
+};
+}
+
+template <typename ... T>
+class any_of : internal::logical_tuple<T...>
+{
+    using internal::logical_tuple<T...>::or_all;
+    using internal::logical_tuple<T...>::and_all;
+    friend struct internal::access;
+public:
+    using internal::logical_tuple<T...>::logical_tuple;
+    using internal::logical_tuple<T...>::find_first;
+    using internal::logical_tuple<T...>::which;
+
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::eq, U, T...>)
+    -> internal::or_result_t<internal::eq, U, T...>
+    {
+        return or_all(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const any_of& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, any_of, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::ne, U, T...>)
+    -> internal::and_result_t<internal::ne, U, T...>
+    {
+        return and_all(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const any_of& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::lt, U, T...>)
+    -> internal::or_result_t<internal::lt, U, T...>
+    {
+        return or_all(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const any_of& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::le, U, T...>)
+    -> internal::or_result_t<internal::le, U, T...>
+    {
+        return or_all(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const any_of& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::gt, U, T...>)
+    -> internal::or_result_t<internal::gt, U, T...>
+    {
+        return or_all(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const any_of& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::ge, U, T...>)
+    -> internal::or_result_t<internal::ge, U, T...>
+    {
+        return or_all(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const any_of& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    // Each member is compared with u once, and the result compares with 0
+    // as the quantifier compares with u, e.g. (q <=> u) < 0 is q < u.
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    constexpr auto operator<=>(const U& u) const
+    -> internal::summary_t<internal::quantifier::any, U, T...>
+    {
+        return {this->order_all(u)};
+    }
+#endif
+    // The quantifier of p applied once to each member, where p is a pointer
+    // to a data member, a pointer to a member function with no parameters,
+    // or a callable, e.g. all_of(o1, o2).by(&order::quantity) > 0. Data
+    // members are referred to, not copied.
+    template <typename P>
+    constexpr auto by(const P& p) const
+    -> any_of<internal::projection_t<P, T>...>
+    {
+        return this->template project_all<any_of<internal::projection_t<P, T>...>>(p);
+    }
+    constexpr explicit operator bool() const
+    noexcept(internal::fold_result_of<true, const T&...>::nothrow)
+    {
+        return or_all([](auto&& v) { return v;});
+    }
+    template <typename ... Ts>
+    constexpr auto operator()(Ts&& ... ts) const
+    noexcept(
+    std::conjunction_v<std::is_nothrow_copy_constructible<T>...> &&
+    std::conjunction_v<std::disjunction<std::is_reference<Ts>, std::is_nothrow_move_constructible<Ts>>...>)
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            any_of<internal::bound<T, Ts...>...>>
+    {
+        using RT = any_of<internal::bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+    // Like operator(), but each callable is called at most once, when its
+    // result is first needed, and the result is kept for later use.
+    template <typename ... Ts>
+    auto memoized(Ts&& ... ts) const
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            any_of<internal::memo_bound<T, Ts...>...>>
+    {
+        using RT = any_of<internal::memo_bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+};
+
+template <typename ... T>
+class none_of : internal::logical_tuple<T...>
+{
+    using internal::logical_tuple<T...>::or_all;
+    using internal::logical_tuple<T...>::and_all;
+    friend struct internal::access;
+public:
+    using internal::logical_tuple<T...>::logical_tuple;
+    using internal::logical_tuple<T...>::find_first;
+    using internal::logical_tuple<T...>::which;
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::eq, U, T...>)
+    -> decltype(!std::declval<internal::or_result_t<internal::eq, U, T...>>())
+    {
+        return !or_all(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const none_of& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, none_of, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::ne, U, T...>)
+    -> decltype(!std::declval<internal::and_result_t<internal::ne, U, T...>>())
+    {
+        return !and_all(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const none_of& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::lt, U, T...>)
+    -> decltype(!std::declval<internal::or_result_t<internal::lt, U, T...>>())
+    {
+        return !or_all(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const none_of& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::le, U, T...>)
+    -> decltype(!std::declval<internal::or_result_t<internal::le, U, T...>>())
+    {
+        return !or_all(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const none_of& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::gt, U, T...>)
+    -> decltype(!std::declval<internal::or_result_t<internal::gt, U, T...>>())
+    {
+        return !or_all(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const none_of& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::ge, U, T...>)
+    -> decltype(!std::declval<internal::or_result_t<internal::ge, U, T...>>())
+    {
+        return !or_all(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const none_of& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    constexpr auto operator<=>(const U& u) const
+    -> internal::summary_t<internal::quantifier::none, U, T...>
+    {
+        return {this->order_all(u)};
+    }
+#endif
+    template <typename P>
+    constexpr auto by(const P& p) const
+    -> none_of<internal::projection_t<P, T>...>
+    {
+        return this->template project_all<none_of<internal::projection_t<P, T>...>>(p);
+    }
+    constexpr explicit operator bool() const
+    noexcept(internal::fold_result_of<true, const T&...>::nothrow)
+    {
+        return !or_all([](auto&& v) { return v;});
+    }
+
+    template <typename ... Ts>
+    constexpr auto operator()(Ts&& ... ts) const
+    noexcept(
+            std::conjunction_v<std::is_nothrow_copy_constructible<T>...> &&
+            std::conjunction_v<std::disjunction<std::is_reference<Ts>, std::is_nothrow_move_constructible<Ts>>...>)
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            none_of<internal::bound<T, Ts...>...>>
+    {
+        using RT = none_of<internal::bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+    // Like operator(), but each callable is called at most once, when its
+    // result is first needed, and the result is kept for later use.
+    template <typename ... Ts>
+    auto memoized(Ts&& ... ts) const
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            none_of<internal::memo_bound<T, Ts...>...>>
+    {
+        using RT = none_of<internal::memo_bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+};
+
+template <typename ... T>
+class all_of : internal::logical_tuple<T...>
+{
+    using internal::logical_tuple<T...>::or_all;
+    using internal::logical_tuple<T...>::and_all;
+    friend struct internal::access;
+public:
+    using internal::logical_tuple<T...>::logical_tuple;
+    using internal::logical_tuple<T...>::find_first;
+    using internal::logical_tuple<T...>::which;
+
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::eq, U, T...>)
+    -> internal::and_result_t<internal::eq, U, T...>
+    {
+        return and_all(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const all_of& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, all_of, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(internal::nothrow_or_v<internal::ne, U, T...>)
+    -> internal::or_result_t<internal::ne, U, T...>
+    {
+        return or_all(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const all_of& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::lt, U, T...>)
+    -> internal::and_result_t<internal::lt, U, T...>
+    {
+        return and_all(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const all_of& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::le, U, T...>)
+    -> internal::and_result_t<internal::le, U, T...>
+    {
+        return and_all(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const all_of& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::gt, U, T...>)
+    -> internal::and_result_t<internal::gt, U, T...>
+    {
+        return and_all(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const all_of& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(internal::nothrow_and_v<internal::ge, U, T...>)
+    -> internal::and_result_t<internal::ge, U, T...>
+    {
+        return and_all(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const all_of& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    constexpr auto operator<=>(const U& u) const
+    -> internal::summary_t<internal::quantifier::all, U, T...>
+    {
+        return {this->order_all(u)};
+    }
+#endif
+    template <typename P>
+    constexpr auto by(const P& p) const
+    -> all_of<internal::projection_t<P, T>...>
+    {
+        return this->template project_all<all_of<internal::projection_t<P, T>...>>(p);
+    }
+    constexpr explicit operator bool() const
+    noexcept(internal::fold_result_of<false, const T&...>::nothrow)
+    {
+        return and_all([](auto&& v) -> bool { return v;});
+    }
+    template <typename ... Ts>
+    constexpr auto operator()(Ts&& ... ts) const
+    noexcept(
+            std::conjunction_v<std::is_nothrow_copy_constructible<T>...> &&
+            std::conjunction_v<std::disjunction<std::is_reference<Ts>, std::is_nothrow_move_constructible<Ts>>...>)
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            all_of<internal::bound<T, Ts...>...>>
+    {
+        using RT = all_of<internal::bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+    // Like operator(), but each callable is called at most once, when its
+    // result is first needed, and the result is kept for later use.
+    template <typename ... Ts>
+    auto memoized(Ts&& ... ts) const
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            all_of<internal::memo_bound<T, Ts...>...>>
+    {
+        using RT = all_of<internal::memo_bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+};
+
+
+// Compares true when the comparison holds for at least Min, and at most
+// Max, of the members. Members are only compared until the result is
+// known. Create with at_least, at_most, exactly or one_of. != is the
+// negation of ==, as for the other quantifiers.
+template <std::size_t Min, std::size_t Max, typename ... T>
+class count_of : internal::logical_tuple<T...>
+{
+    friend struct internal::access;
+public:
+    using internal::logical_tuple<T...>::logical_tuple;
+
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(internal::nothrow_count_v<internal::eq, U, T...>)
+    -> internal::count_result_t<internal::eq, U, T...>
+    {
+        return this->template count_all<Min, Max>(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const count_of& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, count_of, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(internal::nothrow_count_v<internal::eq, U, T...>)
+    -> internal::count_result_t<internal::eq, U, T...>
+    {
+        return !this->template count_all<Min, Max>(internal::eq{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const count_of& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(internal::nothrow_count_v<internal::lt, U, T...>)
+    -> internal::count_result_t<internal::lt, U, T...>
+    {
+        return this->template count_all<Min, Max>(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const count_of& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(internal::nothrow_count_v<internal::le, U, T...>)
+    -> internal::count_result_t<internal::le, U, T...>
+    {
+        return this->template count_all<Min, Max>(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const count_of& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(internal::nothrow_count_v<internal::gt, U, T...>)
+    -> internal::count_result_t<internal::gt, U, T...>
+    {
+        return this->template count_all<Min, Max>(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const count_of& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(internal::nothrow_count_v<internal::ge, U, T...>)
+    -> internal::count_result_t<internal::ge, U, T...>
+    {
+        return this->template count_all<Min, Max>(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const count_of& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+    template <typename P>
+    constexpr auto by(const P& p) const
+    -> count_of<Min, Max, internal::projection_t<P, T>...>
+    {
+        return this->template project_all<count_of<Min, Max, internal::projection_t<P, T>...>>(p);
+    }
+    constexpr explicit operator bool() const
+    noexcept(internal::all_true_v<noexcept(bool(std::declval<const T&>()))...>)
+    {
+        return this->template count_all<Min, Max>([](auto&& v) -> bool { return v;});
+    }
+    template <typename ... Ts>
+    constexpr auto operator()(Ts&& ... ts) const
+    noexcept(
+            std::conjunction_v<std::is_nothrow_copy_constructible<T>...> &&
+            std::conjunction_v<std::disjunction<std::is_reference<Ts>, std::is_nothrow_move_constructible<Ts>>...>)
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            count_of<Min, Max, internal::bound<T, Ts...>...>>
+    {
+        using RT = count_of<Min, Max, internal::bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+    // Like operator(), but each callable is called at most once, when its
+    // result is first needed, and the result is kept for later use.
+    template <typename ... Ts>
+    auto memoized(Ts&& ... ts) const
+    -> std::enable_if_t<std::conjunction_v<std::is_move_constructible<Ts>...>&&
+                        std::conjunction_v<std::is_invocable<const T&, const Ts&...>...>,
+            count_of<Min, Max, internal::memo_bound<T, Ts...>...>>
+    {
+        using RT = count_of<Min, Max, internal::memo_bound<T, Ts...>...>;
+        return this->template bind<RT>(std::forward<Ts>(ts)...);
+    }
+};
+
+template <typename ... T>
+any_of(T&& ...) -> any_of<T...>;
+template <typename ... T>
+none_of(T&& ...) -> none_of<T...>;
+template <typename ... T>
+all_of(T&& ...) -> all_of<T...>;
+
+namespace internal {
+template <std::size_t Min, std::size_t Max, typename ... T>
+constexpr count_of<Min, Max, T...> make_count_of(T&& ... t)
+{
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+    // The call site of a function cannot be known without a default
+    // argument after the pack, so packs larger than the located factories
+    // below take are all counted as ?:0.
+    return count_of<Min, Max, T...>(call_site{}, std::forward<T>(t)...);
+#else
+    return count_of<Min, Max, T...>(std::forward<T>(t)...);
+#endif
+}
+
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+// With instrumentation, the counting factories take up to this many
+// members one by one, followed by a defaulted call site argument.
+inline constexpr std::size_t located_count_limit = 8;
+
+// The type of the members not passed to a located counting factory.
+struct absent {};
+
+// The call site of the call it is a defaulted argument of. The constructor
+// is explicit, so that no member converts to it.
+struct here : call_site
+{
+#if defined(__cpp_lib_source_location)
+    explicit constexpr here(std::source_location l = std::source_location::current())
+    : call_site{l.file_name(), static_cast<unsigned>(l.line())} {}
+#else
+    explicit constexpr here(const char* file = __builtin_FILE(), unsigned line = __builtin_LINE())
+    : call_site{file, line} {}
+#endif
+};
+
+template <std::size_t Min, std::size_t Max, typename Types, typename Args, std::size_t ... I>
+constexpr count_of<Min, Max, std::tuple_element_t<I, Types>...>
+count_of_prefix(call_site site, Args&& args, std::index_sequence<I...>)
+{
+    return count_of<Min, Max, std::tuple_element_t<I, Types>...>(site, std::get<I>(std::move(args))...);
+}
+// A count_of, created at site, of the members of t that are not absent,
+// which are all last.
+template <std::size_t Min, std::size_t Max, typename ... T>
+constexpr auto make_located_count_of(const here& site, T&& ... t)
+{
+    constexpr std::size_t n = sizeof...(T) - (std::size_t{std::is_same_v<T, absent>} + ...);
+    return count_of_prefix<Min, Max, std::tuple<T...>>(site, std::forward_as_tuple(std::forward<T>(t)...),
+                                                       std::make_index_sequence<n>{});
+}
+template <typename ... T>
+using unlocated_t = std::enable_if_t<(sizeof...(T) > located_count_limit)>;
+#else
+template <typename ...>
+using unlocated_t = void;
+#endif
+}
+
+// E.g. x == at_least<2>(a, b, c) is whether x equals two or more of a, b
+// and c.
+template <std::size_t K, typename ... T, typename = internal::unlocated_t<T...>>
+constexpr count_of<K, internal::unbounded, T...> at_least(T&& ... t)
+{
+    return internal::make_count_of<K, internal::unbounded>(std::forward<T>(t)...);
+}
+template <std::size_t K, typename ... T, typename = internal::unlocated_t<T...>>
+constexpr count_of<0, K, T...> at_most(T&& ... t)
+{
+    return internal::make_count_of<0, K>(std::forward<T>(t)...);
+}
+template <std::size_t K, typename ... T, typename = internal::unlocated_t<T...>>
+constexpr count_of<K, K, T...> exactly(T&& ... t)
+{
+    return internal::make_count_of<K, K>(std::forward<T>(t)...);
+}
+template <typename ... T, typename = internal::unlocated_t<T...>>
+constexpr count_of<1, 1, T...> one_of(T&& ... t)
+{
+    return internal::make_count_of<1, 1>(std::forward<T>(t)...);
+}
+
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+// The same factories for packs of up to internal::located_count_limit
+// members, that record the call site.
+template <std::size_t K,
+          typename T0 = internal::absent, typename T1 = internal::absent, typename T2 = internal::absent,
+          typename T3 = internal::absent, typename T4 = internal::absent, typename T5 = internal::absent,
+          typename T6 = internal::absent, typename T7 = internal::absent>
+constexpr auto at_least(T0&& t0 = {}, T1&& t1 = {}, T2&& t2 = {}, T3&& t3 = {},
+                        T4&& t4 = {}, T5&& t5 = {}, T6&& t6 = {}, T7&& t7 = {},
+                        internal::here site = internal::here())
+{
+    return internal::make_located_count_of<K, internal::unbounded>(
+        site, std::forward<T0>(t0), std::forward<T1>(t1), std::forward<T2>(t2), std::forward<T3>(t3),
+        std::forward<T4>(t4), std::forward<T5>(t5), std::forward<T6>(t6), std::forward<T7>(t7));
+}
+template <std::size_t K,
+          typename T0 = internal::absent, typename T1 = internal::absent, typename T2 = internal::absent,
+          typename T3 = internal::absent, typename T4 = internal::absent, typename T5 = internal::absent,
+          typename T6 = internal::absent, typename T7 = internal::absent>
+constexpr auto at_most(T0&& t0 = {}, T1&& t1 = {}, T2&& t2 = {}, T3&& t3 = {},
+                       T4&& t4 = {}, T5&& t5 = {}, T6&& t6 = {}, T7&& t7 = {},
+                       internal::here site = internal::here())
+{
+    return internal::make_located_count_of<0, K>(
+        site, std::forward<T0>(t0), std::forward<T1>(t1), std::forward<T2>(t2), std::forward<T3>(t3),
+        std::forward<T4>(t4), std::forward<T5>(t5), std::forward<T6>(t6), std::forward<T7>(t7));
+}
+template <std::size_t K,
+          typename T0 = internal::absent, typename T1 = internal::absent, typename T2 = internal::absent,
+          typename T3 = internal::absent, typename T4 = internal::absent, typename T5 = internal::absent,
+          typename T6 = internal::absent, typename T7 = internal::absent>
+constexpr auto exactly(T0&& t0 = {}, T1&& t1 = {}, T2&& t2 = {}, T3&& t3 = {},
+                       T4&& t4 = {}, T5&& t5 = {}, T6&& t6 = {}, T7&& t7 = {},
+                       internal::here site = internal::here())
+{
+    return internal::make_located_count_of<K, K>(
+        site, std::forward<T0>(t0), std::forward<T1>(t1), std::forward<T2>(t2), std::forward<T3>(t3),
+        std::forward<T4>(t4), std::forward<T5>(t5), std::forward<T6>(t6), std::forward<T7>(t7));
+}
+template <typename T0 = internal::absent, typename T1 = internal::absent, typename T2 = internal::absent,
+          typename T3 = internal::absent, typename T4 = internal::absent, typename T5 = internal::absent,
+          typename T6 = internal::absent, typename T7 = internal::absent>
+constexpr auto one_of(T0&& t0 = {}, T1&& t1 = {}, T2&& t2 = {}, T3&& t3 = {},
+                      T4&& t4 = {}, T5&& t5 = {}, T6&& t6 = {}, T7&& t7 = {},
+                      internal::here site = internal::here())
+{
+    return internal::make_located_count_of<1, 1>(
+        site, std::forward<T0>(t0), std::forward<T1>(t1), std::forward<T2>(t2), std::forward<T3>(t3),
+        std::forward<T4>(t4), std::forward<T5>(t5), std::forward<T6>(t6), std::forward<T7>(t7));
+}
+#endif
+
+template <auto ... V>
+inline constexpr any_of<internal::constant<V>...> any_of_c{};
+template <auto ... V>
+inline constexpr none_of<internal::constant<V>...> none_of_c{};
+template <auto ... V>
+inline constexpr all_of<internal::constant<V>...> all_of_c{};
+
+
+struct sorted_t
+{
+    explicit sorted_t() = default;
+};
+// Tag for constructing an any_of_range, all_of_range or none_of_range over
+// elements that are sorted in ascending order, which enables binary search
+// for equality, and comparing only the first or last element for the
+// relational operators.
+inline constexpr sorted_t sorted{};
+
+namespace internal {
+
+template <typename R>
+using range_element_t = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<R&>()))>>;
+
+template <typename R, typename T, typename = void>
+constexpr bool is_contiguous_range_of_v = false;
+template <typename R, typename T>
+constexpr bool is_contiguous_range_of_v<R, T, std::void_t<range_element_t<R>, decltype(std::size(std::declval<R&>()))>>
+    = std::is_same_v<range_element_t<R>, T>;
+
+// The elements of a range are first[0], first[1] and so on, or, for a
+// range of the data member of the elements of another, that member of
+// each of them.
+template <typename T, typename S>
+struct range_elements
+{
+    const S* first;
+    std::size_t count;
+    const T S::* member;
+
+    constexpr const T& operator[](std::size_t i) const noexcept
+    {
+        return first[i].*member;
+    }
+    // The address of the first element, for vector loads. The others are
+    // stride bytes after it, in the array of S.
+    const unsigned char* bytes() const noexcept
+    {
+        const auto base = reinterpret_cast<const unsigned char*>(first);
+        if (count == 0) return base;
+        return base + (reinterpret_cast<const unsigned char*>(&(first->*member)) - base);
+    }
+    static constexpr std::size_t stride = sizeof(S);
+};
+template <typename T>
+struct range_elements<T, T>
+{
+    const T* first;
+    std::size_t count;
+
+    constexpr const T& operator[](std::size_t i) const noexcept
+    {
+        return first[i];
+    }
+    const unsigned char* bytes() const noexcept
+    {
+        return reinterpret_cast<const unsigned char*>(first);
+    }
+    static constexpr std::size_t stride = sizeof(T);
+};
+
+template <typename T, typename S>
+class logical_range
+{
+protected:
+    constexpr logical_range(range_elements<T, S> e_, bool sorted_) noexcept
+    : e(e_), is_sorted(sorted_) {}
+
+    template <typename F>
+    constexpr bool or_all(F&& f) const
+    {
+        for (std::size_t i = 0; i != e.count; ++i)
+        {
+            if (f(e[i])) return true;
+        }
+        return false;
+    }
+    template <typename F>
+    constexpr bool and_all(F&& f) const
+    {
+        for (std::size_t i = 0; i != e.count; ++i)
+        {
+            if (!f(e[i])) return false;
+        }
+        return true;
+    }
+    template <typename Op, typename U>
+    constexpr bool or_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return or_all(op, load_once(u));
+        else
+        {
+            if constexpr (is_relop_v<Op> && std::is_same_v<U, T>)
+            {
+                if (is_sorted && e.count != 0)
+                {
+                    if constexpr (std::is_same_v<Op, eq>) return contains(u);
+                    if constexpr (std::is_same_v<Op, ne>) return !(e[0] == u && e[e.count - 1] == u);
+                    if constexpr (std::is_same_v<Op, lt> || std::is_same_v<Op, le>) return op(e[0], u);
+                    if constexpr (std::is_same_v<Op, gt> || std::is_same_v<Op, ge>) return op(e[e.count - 1], u);
+                }
+            }
+#if defined(__GNUC__)
+            if constexpr (is_relop_v<Op> && std::is_same_v<U, T> && simd::vectorizable_v<T>)
+            {
+                if (!is_constant_evaluated()) return simd::reduce<false>(op, e.bytes(), e.count, u, e.stride);
+            }
+#endif
+            return or_all([&](const T& v) { return op(v, u);});
+        }
+    }
+    template <typename Op, typename U>
+    constexpr bool and_all(Op op, const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return and_all(op, load_once(u));
+        else
+        {
+            if constexpr (is_relop_v<Op> && std::is_same_v<U, T>)
+            {
+                if (is_sorted && e.count != 0)
+                {
+                    if constexpr (std::is_same_v<Op, eq>) return e[0] == u && e[e.count - 1] == u;
+                    if constexpr (std::is_same_v<Op, ne>) return !contains(u);
+                    if constexpr (std::is_same_v<Op, lt> || std::is_same_v<Op, le>) return op(e[e.count - 1], u);
+                    if constexpr (std::is_same_v<Op, gt> || std::is_same_v<Op, ge>) return op(e[0], u);
+                }
+            }
+#if defined(__GNUC__)
+            if constexpr (is_relop_v<Op> && std::is_same_v<U, T> && simd::vectorizable_v<T>)
+            {
+                if (!is_constant_evaluated()) return simd::reduce<true>(op, e.bytes(), e.count, u, e.stride);
+            }
+#endif
+            return and_all([&](const T& v) { return op(v, u);});
+        }
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    template <typename U>
+    constexpr orderings order_all(const U& u) const
+    {
+        if constexpr (is_atomic_v<U>)
+            return order_all(load_once(u));
+        else
+        {
+            if constexpr (std::is_same_v<U, T>)
+            {
+                if (is_sorted && e.count != 0)
+                {
+                    const bool l = e[0] < u;
+                    const bool q = contains(u);
+                    const bool g = e[e.count - 1] > u;
+                    return {l, q, g, !(l || q || g)};
+                }
+            }
+#if defined(__GNUC__)
+            if constexpr (std::is_same_v<U, T> && simd::vectorizable_v<T>)
+            {
+                if (!is_constant_evaluated()) return simd::order(e.bytes(), e.count, u, e.stride);
+            }
+#endif
+            orderings r{false, false, false, false};
+            for (std::size_t i = 0; i != e.count; ++i) add_ordering(r, e[i] <=> u);
+            return r;
+        }
+    }
+#endif
+    constexpr range_elements<T, S> elements() const noexcept
+    {
+        return e;
+    }
+    // The data member m of each element, which is read where it is.
+    template <typename M, typename C>
+    constexpr range_elements<M, T> project(const M C::* m) const noexcept
+    {
+        return {e.first, e.count, m};
+    }
+    constexpr bool ordered() const noexcept
+    {
+        return is_sorted;
+    }
+private:
+    // Branch free lower bound, for sorted ranges.
+    constexpr bool contains(const T& u) const
+    {
+        std::size_t i = 0;
+        for (std::size_t n = e.count; n > 1; n -= n / 2)
+        {
+            i = e[i + n / 2 - 1] < u ? i + n / 2 : i;
+        }
+        return e[i] == u;
+    }
+    range_elements<T, S> e;
+    bool is_sorted;
+};
+
+// Whether a range of T can be projected on its data member M C::*. Only
+// ranges of the elements themselves can, i.e. projections do not nest.
+template <typename M, typename C, typename T, typename S>
+constexpr bool projectable_v = std::is_object_v<M> && !std::is_volatile_v<M> &&
+                               std::is_base_of_v<C, T> && std::is_same_v<T, S>;
+}
+
+template <typename T, typename S>
+class any_of_range : internal::logical_range<T, S>
+{
+    friend struct internal::access;
+    using internal::logical_range<T, S>::or_all;
+    using internal::logical_range<T, S>::and_all;
+    template <typename, typename>
+    friend class any_of_range;
+    constexpr explicit any_of_range(internal::range_elements<T, S> e) noexcept
+    : internal::logical_range<T, S>(e, false) {}
+public:
+    constexpr any_of_range(const T* first, std::size_t size) noexcept
+    : internal::logical_range<T, S>({first, size}, false) {}
+    constexpr any_of_range(const T* first, std::size_t size, sorted_t) noexcept
+    : internal::logical_range<T, S>({first, size}, true) {}
+    template <typename R, typename = std::enable_if_t<internal::is_contiguous_range_of_v<const R, T>>>
+    constexpr any_of_range(const R& r) noexcept
+    : internal::logical_range<T, S>({std::data(r), std::size(r)}, false) {}
+    template <typename R, typename = std::enable_if_t<internal::is_contiguous_range_of_v<const R, T>>>
+    constexpr any_of_range(const R& r, sorted_t) noexcept
+    : internal::logical_range<T, S>({std::data(r), std::size(r)}, true) {}
+
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() == u)))
+    -> decltype(bool(std::declval<const T&>() == u))
+    {
+        return or_all(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const any_of_range& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, any_of_range, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() != u)))
+    -> decltype(bool(std::declval<const T&>() != u))
+    {
+        return and_all(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const any_of_range& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() < u)))
+    -> decltype(bool(std::declval<const T&>() < u))
+    {
+        return or_all(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const any_of_range& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() <= u)))
+    -> decltype(bool(std::declval<const T&>() <= u))
+    {
+        return or_all(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const any_of_range& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() > u)))
+    -> decltype(bool(std::declval<const T&>() > u))
+    {
+        return or_all(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const any_of_range& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() >= u)))
+    -> decltype(bool(std::declval<const T&>() >= u))
+    {
+        return or_all(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const any_of_range& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    // Each member is compared with u once, and the result compares with 0
+    // as the quantifier compares with u, e.g. (q <=> u) < 0 is q < u.
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    constexpr auto operator<=>(const U& u) const
+    -> internal::summary_t<internal::quantifier::any, U, T>
+    {
+        return {this->order_all(u)};
+    }
+#endif
+    // The range of the data member m of each element, which is read where
+    // it is, e.g. any_of_range(orders).by(&order::status) == open. Ranges
+    // of arithmetic data members are compared with gathered vector loads.
+    template <typename M, typename C, typename = std::enable_if_t<internal::projectable_v<M, C, T, S>>>
+    constexpr any_of_range<M, T> by(const M C::* m) const noexcept
+    {
+        return any_of_range<M, T>(this->project(m));
+    }
+    constexpr explicit operator bool() const
+    {
+        return or_all([](const T& v) { return bool(v);});
+    }
+};
+
+template <typename R>
+any_of_range(const R&) -> any_of_range<internal::range_element_t<const R>>;
+template <typename R>
+any_of_range(const R&, sorted_t) -> any_of_range<internal::range_element_t<const R>>;
+
+template <typename T, typename S>
+class none_of_range : internal::logical_range<T, S>
+{
+    friend struct internal::access;
+    using internal::logical_range<T, S>::or_all;
+    using internal::logical_range<T, S>::and_all;
+    template <typename, typename>
+    friend class none_of_range;
+    constexpr explicit none_of_range(internal::range_elements<T, S> e) noexcept
+    : internal::logical_range<T, S>(e, false) {}
+public:
+    constexpr none_of_range(const T* first, std::size_t size) noexcept
+    : internal::logical_range<T, S>({first, size}, false) {}
+    constexpr none_of_range(const T* first, std::size_t size, sorted_t) noexcept
+    : internal::logical_range<T, S>({first, size}, true) {}
+    template <typename R, typename = std::enable_if_t<internal::is_contiguous_range_of_v<const R, T>>>
+    constexpr none_of_range(const R& r) noexcept
+    : internal::logical_range<T, S>({std::data(r), std::size(r)}, false) {}
+    template <typename R, typename = std::enable_if_t<internal::is_contiguous_range_of_v<const R, T>>>
+    constexpr none_of_range(const R& r, sorted_t) noexcept
+    : internal::logical_range<T, S>({std::data(r), std::size(r)}, true) {}
+
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() == u)))
+    -> decltype(bool(std::declval<const T&>() == u))
+    {
+        return !or_all(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const none_of_range& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, none_of_range, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() != u)))
+    -> decltype(bool(std::declval<const T&>() != u))
+    {
+        return !and_all(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const none_of_range& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() < u)))
+    -> decltype(bool(std::declval<const T&>() < u))
+    {
+        return !or_all(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const none_of_range& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() <= u)))
+    -> decltype(bool(std::declval<const T&>() <= u))
+    {
+        return !or_all(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const none_of_range& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() > u)))
+    -> decltype(bool(std::declval<const T&>() > u))
+    {
+        return !or_all(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const none_of_range& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() >= u)))
+    -> decltype(bool(std::declval<const T&>() >= u))
+    {
+        return !or_all(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const none_of_range& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    constexpr auto operator<=>(const U& u) const
+    -> internal::summary_t<internal::quantifier::none, U, T>
+    {
+        return {this->order_all(u)};
+    }
+#endif
+    template <typename M, typename C, typename = std::enable_if_t<internal::projectable_v<M, C, T, S>>>
+    constexpr none_of_range<M, T> by(const M C::* m) const noexcept
+    {
+        return none_of_range<M, T>(this->project(m));
+    }
+    constexpr explicit operator bool() const
+    {
+        return !or_all([](const T& v) { return bool(v);});
+    }
+};
+
+template <typename R>
+none_of_range(const R&) -> none_of_range<internal::range_element_t<const R>>;
+template <typename R>
+none_of_range(const R&, sorted_t) -> none_of_range<internal::range_element_t<const R>>;
+
+template <typename T, typename S>
+class all_of_range : internal::logical_range<T, S>
+{
+    friend struct internal::access;
+    using internal::logical_range<T, S>::or_all;
+    using internal::logical_range<T, S>::and_all;
+    template <typename, typename>
+    friend class all_of_range;
+    constexpr explicit all_of_range(internal::range_elements<T, S> e) noexcept
+    : internal::logical_range<T, S>(e, false) {}
+public:
+    constexpr all_of_range(const T* first, std::size_t size) noexcept
+    : internal::logical_range<T, S>({first, size}, false) {}
+    constexpr all_of_range(const T* first, std::size_t size, sorted_t) noexcept
+    : internal::logical_range<T, S>({first, size}, true) {}
+    template <typename R, typename = std::enable_if_t<internal::is_contiguous_range_of_v<const R, T>>>
+    constexpr all_of_range(const R& r) noexcept
+    : internal::logical_range<T, S>({std::data(r), std::size(r)}, false) {}
+    template <typename R, typename = std::enable_if_t<internal::is_contiguous_range_of_v<const R, T>>>
+    constexpr all_of_range(const R& r, sorted_t) noexcept
+    : internal::logical_range<T, S>({std::data(r), std::size(r)}, true) {}
+
+    template <typename U>
+    constexpr auto operator==(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() == u)))
+    -> decltype(bool(std::declval<const T&>() == u))
+    {
+        return and_all(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend constexpr auto operator==(const U& u, const all_of_range& a)
+    noexcept(noexcept(a == u))
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, all_of_range, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    constexpr auto operator!=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() != u)))
+    -> decltype(bool(std::declval<const T&>() != u))
+    {
+        return or_all(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator!=(const U& u, const all_of_range& a)
+    noexcept(noexcept(a != u))
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    constexpr auto operator<(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() < u)))
+    -> decltype(bool(std::declval<const T&>() < u))
+    {
+        return and_all(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>(const U& u, const all_of_range& a)
+    noexcept(noexcept(a < u))
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    constexpr auto operator<=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() <= u)))
+    -> decltype(bool(std::declval<const T&>() <= u))
+    {
+        return and_all(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator>=(const U& u, const all_of_range& a)
+    noexcept(noexcept(a <= u))
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    constexpr auto operator>(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() > u)))
+    -> decltype(bool(std::declval<const T&>() > u))
+    {
+        return and_all(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<(const U& u, const all_of_range& a)
+    noexcept(noexcept(a > u))
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    constexpr auto operator>=(const U& u) const
+    noexcept(noexcept(bool(std::declval<const T&>() >= u)))
+    -> decltype(bool(std::declval<const T&>() >= u))
+    {
+        return and_all(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend constexpr auto operator<=(const U& u, const all_of_range& a)
+    noexcept(noexcept(a >= u))
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+#if defined(__cpp_lib_three_way_comparison)
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    constexpr auto operator<=>(const U& u) const
+    -> internal::summary_t<internal::quantifier::all, U, T>
+    {
+        return {this->order_all(u)};
+    }
+#endif
+    template <typename M, typename C, typename = std::enable_if_t<internal::projectable_v<M, C, T, S>>>
+    constexpr all_of_range<M, T> by(const M C::* m) const noexcept
+    {
+        return all_of_range<M, T>(this->project(m));
+    }
+    constexpr explicit operator bool() const
+    {
+        return and_all([](const T& v) { return bool(v);});
+    }
+};
+
+template <typename R>
+all_of_range(const R&) -> all_of_range<internal::range_element_t<const R>>;
+template <typename R>
+all_of_range(const R&, sorted_t) -> all_of_range<internal::range_element_t<const R>>;
+
+// Replaces the value of a with desired if it compares equal to q, e.g.
+// compare_exchange(state, any_of(S1, S3), S2) moves state to S2 only from
+// S1 or S3. Returns whether it did. The value compared is the one that is
+// replaced, as with compare_exchange_weak, which is retried while the value
+// still compares equal.
+template <typename T, typename Q, typename = std::enable_if_t<internal::is_quantifier_v<Q>>>
+auto compare_exchange(std::atomic<T>& a, const Q& q, const std::common_type_t<T>& desired,
+                      std::memory_order success = std::memory_order_acq_rel,
+                      std::memory_order failure = std::memory_order_acquire)
+-> decltype(bool(std::declval<const T&>() == q))
+{
+    T current = a.load(failure);
+    while (bool(current == q))
+    {
+        if (a.compare_exchange_weak(current, desired, success, failure)) return true;
+    }
+    return false;
+}
+
+// Comparisons of these types have no side effects, so their order of
+// evaluation can be changed without changing the results. Specialize for
+// other types with side effect free comparisons to use them with
+// adaptive_any_of.
+template <typename T>
+struct pure_comparison
+    : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> ||
+                         std::is_same_v<T, std::string_view>>
+{};
+template <auto V>
+struct pure_comparison<internal::constant<V>> : pure_comparison<decltype(V)> {};
+
+#ifndef DRY_COMPARISONS_ADAPT_PERIOD
+// The number of comparisons an adaptive_any_of makes between each
+// reordering of its members.
+#define DRY_COMPARISONS_ADAPT_PERIOD 256
+#endif
+
+namespace internal {
+
+// A value that several threads may read and write at once, one access at
+// a time and with no ordering between them, and that copies as its value.
+template <typename T>
+class relaxed
+{
+public:
+    constexpr relaxed(T t = T{}) noexcept : value(t) {}
+    relaxed(const relaxed& r) noexcept : value(r.load()) {}
+    relaxed& operator=(const relaxed& r) noexcept { store(r.load()); return *this; }
+    T load() const noexcept { return value.load(std::memory_order_relaxed); }
+    void store(T t) noexcept { value.store(t, std::memory_order_relaxed); }
+private:
+    std::atomic<T> value;
+};
+
+}
+
+// Like any_of, but the members are compared in the order of how often
+// each has decided the result of a comparison, most often first. The order
+// is recomputed every DRY_COMPARISONS_ADAPT_PERIOD comparisons, from
+// counts that are then halved, so that it follows changes in the input.
+// The results are the same as those of any_of. An instance may be compared
+// from several threads at once. The counts are then shared, and some
+// increments may be lost, but the order is always a whole permutation,
+// since it is packed into one atomic word of 4 bits per member.
+template <typename ... T>
+class adaptive_any_of : internal::logical_tuple<T...>
+{
+    friend struct internal::access;
+    static_assert(internal::all_true_v<pure_comparison<T>::value...>,
+                  "adaptive_any_of reorders comparisons, so they must be free from side effects."
+                  " Specialize rollbear::pure_comparison for types where they are.");
+    static constexpr std::size_t size = sizeof...(T);
+    static constexpr unsigned index_bits = 4;
+    static constexpr std::uint64_t index_mask = (std::uint64_t{1} << index_bits) - 1;
+    static_assert(size <= 64 / index_bits, "adaptive_any_of has at most 16 members.");
+public:
+    constexpr adaptive_any_of(T ... t)
+    : internal::logical_tuple<T...>(std::move(t)...)
+    , order(identity())
+    {
+    }
+
+    template <typename U>
+    auto operator==(const U& u) const
+    -> decltype(std::declval<internal::and_result_t<internal::eq, U, T...>>(), bool())
+    {
+        return reordered<true>(internal::eq{}, u);
+    }
+#if !(defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907)
+    template <typename U>
+    friend auto operator==(const U& u, const adaptive_any_of& a)
+    -> internal::eq_type_t<!internal::is_quantifier_v<U>, adaptive_any_of, U>
+    {
+        return a == u;
+    }
+#endif
+    template <typename U>
+    auto operator!=(const U& u) const
+    -> decltype(std::declval<internal::and_result_t<internal::ne, U, T...>>(), bool())
+    {
+        return reordered<false>(internal::ne{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend auto operator!=(const U& u, const adaptive_any_of& a)
+    -> decltype(a != u)
+    {
+        return a != u;
+    }
+    template <typename U>
+    auto operator<(const U& u) const
+    -> decltype(std::declval<internal::and_result_t<internal::lt, U, T...>>(), bool())
+    {
+        return reordered<true>(internal::lt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend auto operator>(const U& u, const adaptive_any_of& a)
+    -> decltype(a < u)
+    {
+        return a < u;
+    }
+    template <typename U>
+    auto operator<=(const U& u) const
+    -> decltype(std::declval<internal::and_result_t<internal::le, U, T...>>(), bool())
+    {
+        return reordered<true>(internal::le{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend auto operator>=(const U& u, const adaptive_any_of& a)
+    -> decltype(a <= u)
+    {
+        return a <= u;
+    }
+    template <typename U>
+    auto operator>(const U& u) const
+    -> decltype(std::declval<internal::and_result_t<internal::gt, U, T...>>(), bool())
+    {
+        return reordered<true>(internal::gt{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend auto operator<(const U& u, const adaptive_any_of& a)
+    -> decltype(a > u)
+    {
+        return a > u;
+    }
+    template <typename U>
+    auto operator>=(const U& u) const
+    -> decltype(std::declval<internal::and_result_t<internal::ge, U, T...>>(), bool())
+    {
+        return reordered<true>(internal::ge{}, u);
+    }
+    template <typename U, typename = std::enable_if_t<!internal::is_quantifier_v<U>>>
+    friend auto operator<=(const U& u, const adaptive_any_of& a)
+    -> decltype(a >= u)
+    {
+        return a >= u;
+    }
+    // The indexes of the members, in the order they are compared.
+    std::array<std::size_t, size> evaluation_order() const noexcept
+    {
+        std::array<std::size_t, size> r{};
+        std::uint64_t o = order.load();
+        for (auto& i : r)
+        {
+            i = static_cast<std::size_t>(o & index_mask);
+            o >>= index_bits;
+        }
+        return r;
+    }
+private:
+    static constexpr std::uint64_t identity() noexcept
+    {
+        std::uint64_t o = 0;
+        for (std::size_t i = 0; i != size; ++i) o |= std::uint64_t{i} << (i * index_bits);
+        return o;
+    }
+    template <bool Or, typename Op, typename U>
+    bool reordered(Op op, const U& u) const
+    {
+        if constexpr (internal::is_atomic_v<U>)
+        {
+            return reordered<Or>(op, internal::load_once(u));
+        }
+        else
+        {
+            const std::size_t decider = decide<Or, Op>(u, std::index_sequence_for<T...>{});
+            if (decider != size) hits[decider].store(hits[decider].load() + 1);
+            const std::uint32_t c = calls.load() + 1;
+            calls.store(c);
+            if (c >= DRY_COMPARISONS_ADAPT_PERIOD) reorder();
+            return (decider != size) == Or;
+        }
+    }
+    // The index of the first member, in the current order, whose
+    // comparison is Or, or size if there is none. The member at an index
+    // is picked by a fold over the indexes, which the compiler can turn
+    // into a jump, and inline the comparisons in.
+    template <bool Or, typename Op, typename U, std::size_t ... I>
+    std::size_t decide(const U& u, std::index_sequence<I...>) const
+    {
+        return this->apply([&](const auto& ... v) {
+            std::uint64_t o = order.load();
+            for (std::size_t k = 0; k != size; ++k, o >>= index_bits)
+            {
+                const auto i = static_cast<std::size_t>(o & index_mask);
+                bool r = !Or;
+                static_cast<void>(((i == I && (r = bool(Op{}(v, u)), true)) || ...));
+                if (r == Or) return i;
+            }
+            return size;
+        });
+    }
+    void reorder() const noexcept
+    {
+        // Stable insertion sort of the current order, most hits first,
+        // since packs are small.
+        std::uint32_t h[size];
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            h[i] = hits[i].load();
+            hits[i].store(h[i] / 2);
+        }
+        std::size_t o[size];
+        std::uint64_t current = order.load();
+        for (std::size_t k = 0; k != size; ++k, current >>= index_bits)
+        {
+            const auto i = static_cast<std::size_t>(current & index_mask);
+            std::size_t m = k;
+            for (; m != 0 && h[o[m - 1]] < h[i]; --m) o[m] = o[m - 1];
+            o[m] = i;
+        }
+        std::uint64_t packed = 0;
+        for (std::size_t k = 0; k != size; ++k) packed |= std::uint64_t{o[k]} << (k * index_bits);
+        order.store(packed);
+        calls.store(0);
+    }
+    mutable internal::relaxed<std::uint64_t> order;
+    mutable internal::relaxed<std::uint32_t> hits[size] = {};
+    mutable internal::relaxed<std::uint32_t> calls = 0;
+};
+
+template <typename ... T>
+adaptive_any_of(T ...) -> adaptive_any_of<T...>;
+
+namespace internal {
+
+template <typename>
+struct quantifier_of;
+template <typename ... T>
+struct quantifier_of<any_of<T...>> : std::integral_constant<quantifier, quantifier::any> {};
+template <typename ... T>
+struct quantifier_of<all_of<T...>> : std::integral_constant<quantifier, quantifier::all> {};
+template <typename ... T>
+struct quantifier_of<none_of<T...>> : std::integral_constant<quantifier, quantifier::none> {};
+
+}
+
+#if defined(DRY_COMPARISONS_INSTRUMENT)
+namespace instrumentation {
+
+// The counts for one call site, summed over all threads.
+struct site_statistics
+{
+    const char* file;
+    unsigned line;
+    // The number of comparisons, and conversions to bool, made.
+    std::uint64_t calls;
+    // The number of members compared, in total, before the result was known.
+    std::uint64_t comparisons;
+    // decided_by[i] is the number of calls where member i decided the
+    // result, i.e. compared true for an any_of or none_of, or false for an
+    // all_of. The last element also counts the members after it.
+    std::vector<std::uint64_t> decided_by;
+    // The number of calls where all members had to be compared.
+    std::uint64_t undecided;
+};
+
+// The counts of all call sites so far, in no particular order. It can be
+// called while other threads are counting.
+inline std::vector<site_statistics> snapshot()
+{
+    using namespace internal::instrumentation;
+    std::vector<site_statistics> result;
+    std::unordered_map<std::pair<const char*, unsigned>, std::size_t, site_hash> index;
+    auto& r = registry::instance();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& s : r.shards)
+    {
+        std::lock_guard<std::mutex> shard_lock(s->mutex);
+        for (auto& [key, c] : s->sites)
+        {
+            auto [i, added] = index.emplace(key, result.size());
+            if (added) result.push_back({key.first, key.second, 0, 0, {}, 0});
+            auto& stats = result[i->second];
+            const auto relaxed = std::memory_order_relaxed;
+            stats.calls += c->calls.load(relaxed);
+            stats.comparisons += c->comparisons.load(relaxed);
+            std::size_t used = max_members;
+            while (used != 0 && c->decided_by[used - 1].load(relaxed) == 0) --used;
+            if (stats.decided_by.size() < used) stats.decided_by.resize(used);
+            for (std::size_t m = 0; m != used; ++m) stats.decided_by[m] += c->decided_by[m].load(relaxed);
+        }
+    }
+    for (auto& stats : result)
+    {
+        std::uint64_t decided = 0;
+        for (auto d : stats.decided_by) decided += d;
+        stats.undecided = stats.calls - decided;
+    }
+    return result;
+}
+
+// The number of comparisons that were not counted, because memory for the
+// counters of a new call site, or thread, could not be allocated.
+inline std::uint64_t dropped() noexcept
+{
+    return internal::instrumentation::registry::instance().dropped.load(std::memory_order_relaxed);
+}
+
+// Writes one line per call site, e.g.
+// main.cpp:12 calls=1000 comparisons=2500 decided_by=[100,800] undecided=100
+template <typename Char, typename Traits>
+std::basic_ostream<Char, Traits>& dump(std::basic_ostream<Char, Traits>& os)
+{
+    for (auto& stats : snapshot())
+    {
+        os << stats.file << ':' << stats.line
+           << " calls=" << stats.calls
+           << " comparisons=" << stats.comparisons
+           << " decided_by=[";
+        for (std::size_t i = 0; i != stats.decided_by.size(); ++i)
+        {
+            os << &","[i == 0] << stats.decided_by[i];
+        }
+        os << "] undecided=" << stats.undecided << '\n';
+    }
+    return os;
+}
+
+}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef DRY_COMPARISONS_CORO_HPP_
+#define DRY_COMPARISONS_CORO_HPP_
+
+#include "dry-comparisons-core.hpp"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+
+namespace rollbear {
+namespace coro {
+
+namespace internal {
+
+// A coroutine that starts immediately and nobody waits for.
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+}
+
+// A lazily started coroutine, producing a T. It starts running when it is
+// awaited, and resumes the awaiting coroutine when it is done.
+template <typename T>
+class task
+{
+public:
+    struct promise_type
+    {
+        task get_return_object() noexcept
+        {
+            return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept
+        {
+            struct transfer
+            {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                {
+                    auto c = h.promise().continuation;
+                    return c ? c : std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            return transfer{};
+        }
+        template <typename U>
+        void return_value(U&& u) { value.emplace(std::forward<U>(u)); }
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+
+        std::coroutine_handle<> continuation;
+        std::optional<T> value;
+        std::exception_ptr error;
+    };
+
+    task(task&& t) noexcept : handle(std::exchange(t.handle, nullptr)) {}
+    task& operator=(task&& t) noexcept
+    {
+        std::swap(handle, t.handle);
+        return *this;
+    }
+    ~task()
+    {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume()
+    {
+        auto& p = handle.promise();
+        if (p.error) std::rethrow_exception(p.error);
+        return std::move(*p.value);
+    }
+private:
+    explicit task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+    std::coroutine_handle<promise_type> handle;
+};
+
+// A single threaded executor. Coroutines that co_await schedule() are
+// queued, and resumed in order by run().
+class local_executor
+{
+public:
+    auto schedule() noexcept
+    {
+        struct awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { queue.push_back(h); }
+            void await_resume() const noexcept {}
+            std::deque<std::coroutine_handle<>>& queue;
+        };
+        return awaiter{queue};
+    }
+    // Resumes queued coroutines until there are none left.
+    void run()
+    {
+        while (!queue.empty())
+        {
+            auto h = queue.front();
+            queue.pop_front();
+            h.resume();
+        }
+    }
+    // Runs t, and the coroutines it schedules, to completion, and returns
+    // its result.
+    template <typename T>
+    T run(task<T> t)
+    {
+        std::optional<T> result;
+        std::exception_ptr error;
+        [](task<T>& awaited, std::optional<T>& r, std::exception_ptr& e) -> internal::detached {
+            try { r.emplace(co_await awaited); }
+            catch (...) { e = std::current_exception(); }
+        }(t, result, error);
+        run();
+        if (error) std::rethrow_exception(error);
+        return std::move(*result);
+    }
+private:
+    std::deque<std::coroutine_handle<>> queue;
+};
+
+namespace internal {
+
+template <typename T>
+constexpr bool is_awaitable_v = requires (T& t) { t.await_ready(); } ||
+                                requires (T&& t) { std::move(t).operator co_await(); };
+
+// Shared by the awaiting coroutine and one runner per operand. The first
+// operand whose result equals decider decides the outcome, and resumes the
+// awaiting coroutine. The remaining operands keep running, detached, and
+// their results are ignored.
+struct race
+{
+    race(std::size_t count, bool decider_) noexcept : decider(decider_), remaining(count) {}
+
+    void report(bool r, std::exception_ptr e)
+    {
+        const bool last = remaining.fetch_sub(1) == 1;
+        if (!e && r != decider && !last) return;
+        if (decided.exchange(true)) return;
+        error = e;
+        decided_by_member = e || r == decider;
+        // Whoever of the awaiter and the deciding runner comes second
+        // resumes the awaiting coroutine.
+        if (suspended.exchange(true)) continuation.resume();
+    }
+
+    const bool decider;
+    std::atomic<std::size_t> remaining;
+    std::atomic<bool> decided{false};
+    std::atomic<bool> suspended{false};
+    bool decided_by_member = false;
+    std::exception_ptr error;
+    std::coroutine_handle<> continuation;
+};
+
+template <typename A>
+detached run(std::shared_ptr<race> r, A awaitable)
+{
+    bool result = false;
+    std::exception_ptr error;
+    try
+    {
+        result = static_cast<bool>(co_await std::move(awaitable));
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    r->report(result, error);
+}
+
+template <typename Q>
+class awaiter
+{
+public:
+    explicit awaiter(Q&& q_) : q(std::move(q_)) {}
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h)
+    {
+        using rollbear::internal::quantifier;
+        constexpr quantifier kind = rollbear::internal::quantifier_of<Q>::value;
+        rollbear::internal::access::apply(q, [&](auto& ... as) {
+            state = std::make_shared<race>(sizeof...(as), kind != quantifier::all);
+            state->continuation = h;
+            (run(state, std::move(as)), ...);
+        });
+        return !state->suspended.exchange(true);
+    }
+    bool await_resume() const
+    {
+        using rollbear::internal::quantifier;
+        constexpr quantifier kind = rollbear::internal::quantifier_of<Q>::value;
+        if (state->error) std::rethrow_exception(state->error);
+        const bool hit = state->decided_by_member;
+        return kind == quantifier::any ? hit : !hit;
+    }
+private:
+    Q q;
+    std::shared_ptr<race> state;
+};
+
+template <typename ... T>
+using awaitable_pack_t = std::enable_if_t<sizeof...(T) != 0 &&
+                                          (... && (is_awaitable_v<T> && !std::is_reference_v<T>))>;
+}
+
+}
+
+// Starts all operands at once, and resumes the awaiting coroutine as soon
+// as the result is known, e.g. when the first operand of an any_of gives
+// true. Operands not yet done are detached, and keep running to
+// completion, but their results are ignored. The result is the same as
+// that of the quantifier over the awaited values, converted to bool.
+template <typename ... T, typename = coro::internal::awaitable_pack_t<T...>>
+auto operator co_await(any_of<T...>&& q)
+{
+    return coro::internal::awaiter<any_of<T...>>(std::move(q));
+}
+template <typename ... T, typename = coro::internal::awaitable_pack_t<T...>>
+auto operator co_await(all_of<T...>&& q)
+{
+    return coro::internal::awaiter<all_of<T...>>(std::move(q));
+}
+template <typename ... T, typename = coro::internal::awaitable_pack_t<T...>>
+auto operator co_await(none_of<T...>&& q)
+{
+    return coro::internal::awaiter<none_of<T...>>(std::move(q));
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef DRY_COMPARISONS_PARALLEL_HPP_
+#define DRY_COMPARISONS_PARALLEL_HPP_
+
+#include "dry-comparisons-core.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rollbear {
+namespace parallel {
+
+// A fixed set of worker threads, each with its own queue of tasks. A worker
+// takes the most recently added task from its own queue, and when that is
+// empty, steals the oldest task from the queue of another worker.
+class pool
+{
+public:
+    explicit pool(std::size_t thread_count = default_thread_count())
+    {
+        if (thread_count == 0) thread_count = 1;
+        queues.reserve(thread_count);
+        for (std::size_t i = 0; i != thread_count; ++i)
+        {
+            queues.push_back(std::make_unique<queue>());
+        }
+        threads.reserve(thread_count);
+        for (std::size_t i = 0; i != thread_count; ++i)
+        {
+            threads.emplace_back([this, i] { work(i); });
+        }
+    }
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+    // Runs all tasks already submitted before returning.
+    ~pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : threads) t.join();
+    }
+    std::size_t size() const noexcept { return threads.size(); }
+
+    template <typename F>
+    void submit(F&& f)
+    {
+        auto& q = *queues[next++ % queues.size()];
+        // Counted before it is queued, so take() never decrements pending
+        // for a task it isn't yet included in.
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++pending;
+        }
+        try
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.emplace_back(std::forward<F>(f));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --pending;
+            throw;
+        }
+        wake.notify_one();
+    }
+    // Runs one queued task, if there is one, on the calling thread.
+    bool try_run_one()
+    {
+        std::function<void()> task;
+        if (!take(next % queues.size(), task)) return false;
+        task();
+        return true;
+    }
+private:
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    static std::size_t default_thread_count() noexcept
+    {
+        const auto n = std::thread::hardware_concurrency();
+        return n == 0 ? 2 : n;
+    }
+    bool take(std::size_t own, std::function<void()>& task)
+    {
+        const auto n = queues.size();
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            auto& q = *queues[(own + i) % n];
+            std::unique_lock<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            if (i == 0)
+            {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            lock.unlock();
+            std::lock_guard<std::mutex> count_lock(mutex);
+            --pending;
+            return true;
+        }
+        return false;
+    }
+    void work(std::size_t index)
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || pending != 0; });
+                if (pending == 0) return;
+            }
+            std::function<void()> task;
+            if (take(index, task)) task();
+        }
+    }
+
+    std::vector<std::unique_ptr<queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::size_t pending = 0;
+    bool stopping = false;
+};
+
+// Passed as the last argument to callables that accept it. It tells a
+// long running callable that its result is no longer needed.
+class cancellation
+{
+public:
+    explicit cancellation(const std::atomic<bool>& flag_) noexcept : flag(&flag_) {}
+    bool requested() const noexcept { return flag->load(std::memory_order_relaxed); }
+private:
+    const std::atomic<bool>* flag;
+};
+
+namespace internal {
+
+template <typename F, typename ... Args>
+bool call(const F& f, const cancellation& c, const Args& ... args)
+{
+    if constexpr (std::is_invocable_v<const F&, const Args&..., const cancellation&>)
+        return static_cast<bool>(f(args..., c));
+    else
+        return static_cast<bool>(f(args...));
+}
+
+template <typename Fs, typename Args>
+struct evaluation;
+template <typename ... Fs, typename ... Args>
+struct evaluation<std::tuple<Fs...>, std::tuple<Args...>>
+{
+    template <typename ... Gs, typename ... As>
+    evaluation(bool decider_, const std::tuple<const Gs&...>& fs, As&& ... as)
+    : functions(fs), arguments(std::forward<As>(as)...), decider(decider_), remaining(sizeof...(Fs))
+    {}
+
+    template <std::size_t ... I>
+    static void submit(pool& p, const std::shared_ptr<evaluation>& self, std::index_sequence<I...>)
+    {
+        (p.submit([self] { self->template run<I>(); }), ...);
+    }
+    template <std::size_t I>
+    void run()
+    {
+        if (!decided.load(std::memory_order_acquire))
+        {
+            try
+            {
+                const bool r = std::apply([this](const auto& ... as) {
+                    return call(std::get<I>(functions), cancellation(decided), as...);
+                }, arguments);
+                if (r == decider)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    decide_locked();
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+                decide_locked();
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--remaining == 0) done.notify_all();
+    }
+    void decide_locked()
+    {
+        decided_by_member = true;
+        decided.store(true, std::memory_order_release);
+        done.notify_all();
+    }
+    bool finished()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return decided_by_member || remaining == 0;
+    }
+
+    std::tuple<Fs...> functions;
+    std::tuple<Args...> arguments;
+    const bool decider;
+    std::atomic<bool> decided{false};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t remaining;
+    bool decided_by_member = false;
+    std::exception_ptr error;
+};
+
+}
+
+// Calls the callables of the quantifier q with args on the threads of p, and
+// returns the same as bool(q(args...)), as soon as it is known. That is,
+// when one callable returns true for any_of or none_of, or false for
+// all_of. The callables that have not yet started are then skipped, and
+// those still running are told through their cancellation argument, if
+// they take one. The callables and the arguments are copied, so those
+// still running when evaluate returns can finish in the background.
+//
+// If a callable throws, the first exception is rethrown.
+template <typename Q, typename ... Args>
+bool evaluate(pool& p, const Q& q, Args&& ... args)
+{
+    using rollbear::internal::quantifier;
+    constexpr quantifier kind = rollbear::internal::quantifier_of<Q>::value;
+    constexpr bool decider = kind != quantifier::all;
+    auto state = rollbear::internal::access::apply(q, [&](const auto& ... fs) {
+        using state_type = internal::evaluation<std::tuple<std::decay_t<decltype(fs)>...>,
+                                                std::tuple<std::decay_t<Args>...>>;
+        return std::make_shared<state_type>(decider, std::tuple<const decltype(fs)&...>(fs...),
+                                            std::forward<Args>(args)...);
+    });
+    using state_type = typename decltype(state)::element_type;
+    state_type::submit(p, state, std::make_index_sequence<std::tuple_size_v<decltype(state_type::functions)>>{});
+    // Help with the work rather than block, so that evaluate can be called
+    // from a task of the same pool.
+    while (!state->finished() && p.try_run_one())
+    {
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->decided_by_member || state->remaining == 0; });
+    if (state->error) std::rethrow_exception(state->error);
+    const bool hit = state->decided_by_member;
+    return kind == quantifier::any ? hit : !hit;
+}
+
+}
+}
+
+#endif
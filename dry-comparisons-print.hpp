@@ -0,0 +1,119 @@
+#ifndef DRY_COMPARISONS_PRINT_HPP_
+#define DRY_COMPARISONS_PRINT_HPP_
+
+#include "dry-comparisons-core.hpp"
+
+#include <ostream>
+
+namespace rollbear {
+namespace internal {
+
+template <typename, typename = void>
+struct printable;
+template <typename ... Ts>
+struct printable<std::tuple<Ts...>, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const Ts&>())...>>
+{
+    using type = void;
+};
+template <typename T>
+using printable_t = typename printable<T>::type;
+
+template <typename Char, typename Traits, typename Q>
+std::basic_ostream<Char, Traits>& print_members(const Char* label, std::basic_ostream<Char, Traits>& os, const Q& q)
+{
+    os << label << '{';
+    access::apply(q, [&os](const auto& ... v) {
+        int first = 1;
+        each([&](const auto& m) { os << &","[std::exchange(first, 0)] << m; }, v...);
+    });
+    return os << '}';
+}
+
+template <typename Char, typename Traits, typename Q>
+std::basic_ostream<Char, Traits>& print_elements(const Char* label, std::basic_ostream<Char, Traits>& os, const Q& q)
+{
+    const auto e = access::elements(q);
+    os << label << '{';
+    for (std::size_t i = 0; i != e.count; ++i)
+    {
+        os << &","[i == 0] << e[i];
+    }
+    return os << '}';
+}
+}
+
+// E.g. [1,5], [1,5) or (1,5)
+template <typename T, endpoint Lo, endpoint Hi, typename = internal::printable_t<std::tuple<T>>>
+std::ostream& operator<<(std::ostream& os, const interval<T, Lo, Hi>& self)
+{
+    return os << (Lo == endpoint::closed ? '[' : '(') << self.lo << ','
+              << self.hi << (Hi == endpoint::closed ? ']' : ')');
+}
+// E.g. starts_with("/api/")
+inline std::ostream& operator<<(std::ostream& os, const text_pattern& self)
+{
+    const char* name = self.position == text_position::prefix ? "starts_with"
+                     : self.position == text_position::suffix ? "ends_with"
+                     : "contains";
+    return os << name << "(\"" << self.text << "\")";
+}
+// E.g. icase("content-type")
+inline std::ostream& operator<<(std::ostream& os, const icase_string& self)
+{
+    return os << "icase(\"" << self.text << "\")";
+}
+template <typename ... T, typename = internal::printable_t<std::tuple<T...>>>
+std::ostream& operator<<(std::ostream& os, const any_of<T...>& self)
+{
+    return internal::print_members("any_of", os, self);
+}
+template <typename ... T, typename = internal::printable_t<std::tuple<T...>>>
+std::ostream& operator<<(std::ostream& os, const none_of<T...>& self)
+{
+    return internal::print_members("none_of", os, self);
+}
+template <typename ... T, typename = internal::printable_t<std::tuple<T...>>>
+std::ostream& operator<<(std::ostream& os, const all_of<T...>& self)
+{
+    return internal::print_members("all_of", os, self);
+}
+template <typename ... T, typename = internal::printable_t<std::tuple<T...>>>
+std::ostream& operator<<(std::ostream& os, const adaptive_any_of<T...>& self)
+{
+    return internal::print_members("any_of", os, self);
+}
+// E.g. at_least<2>{1,3,5}, or one_of{1,3,5}
+template <std::size_t Min, std::size_t Max, typename ... T, typename = internal::printable_t<std::tuple<T...>>>
+std::ostream& operator<<(std::ostream& os, const count_of<Min, Max, T...>& self)
+{
+    if constexpr (Min == 1 && Max == 1)
+        os << "one_of";
+    else if constexpr (Max == internal::unbounded)
+        os << "at_least<" << Min << '>';
+    else if constexpr (Min == 0)
+        os << "at_most<" << Max << '>';
+    else if constexpr (Min == Max)
+        os << "exactly<" << Min << '>';
+    else
+        os << "count_of<" << Min << ',' << Max << '>';
+    return internal::print_members("", os, self);
+}
+template <typename T, typename S, typename = internal::printable_t<std::tuple<T>>>
+std::ostream& operator<<(std::ostream& os, const any_of_range<T, S>& self)
+{
+    return internal::print_elements("any_of", os, self);
+}
+template <typename T, typename S, typename = internal::printable_t<std::tuple<T>>>
+std::ostream& operator<<(std::ostream& os, const none_of_range<T, S>& self)
+{
+    return internal::print_elements("none_of", os, self);
+}
+template <typename T, typename S, typename = internal::printable_t<std::tuple<T>>>
+std::ostream& operator<<(std::ostream& os, const all_of_range<T, S>& self)
+{
+    return internal::print_elements("all_of", os, self);
+}
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef DRY_COMPARISONS_SELECT_HPP_
+#define DRY_COMPARISONS_SELECT_HPP_
+
+#include "dry-comparisons-core.hpp"
+
+#include <functional>
+
+namespace rollbear {
+namespace internal {
+
+// The operator applied to each member of a quantifier, when a value is
+// compared with it using the operator F, e.g. v < any_of(...) compares
+// each member m with m > v.
+template <typename F>
+struct member_op;
+template <typename T>
+struct member_op<std::equal_to<T>> { using type = eq; };
+template <typename T>
+struct member_op<std::not_equal_to<T>> { using type = ne; };
+template <typename T>
+struct member_op<std::less<T>> { using type = gt; };
+template <typename T>
+struct member_op<std::less_equal<T>> { using type = ge; };
+template <typename T>
+struct member_op<std::greater<T>> { using type = lt; };
+template <typename T>
+struct member_op<std::greater_equal<T>> { using type = le; };
+
+template <typename T>
+constexpr const T& unwrap(const T& t) noexcept { return t; }
+template <auto V>
+constexpr decltype(V) unwrap(constant<V>) noexcept { return V; }
+
+inline int countr_zero(std::uint64_t v) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1U)) { v >>= 1; ++n; }
+    return n;
+#endif
+}
+
+// Sets bit i of the result iff rows[i] F q, for i in [0, n) with n <= 64.
+// For each member of q, all n rows are compared with that member, and the
+// per row results are accumulated in bytes, or when the members and rows
+// are of the same arithmetic or enum type, in vector registers, which are
+// only packed into a bit mask at the end.
+template <typename F, typename T, typename Q>
+std::uint64_t select_chunk(const T* rows, std::size_t n, const Q& q)
+{
+    using op = typename member_op<F>::type;
+    constexpr quantifier kind = quantifier_of<Q>::value;
+    constexpr bool conjunction = (kind == quantifier::all) != std::is_same_v<op, ne>;
+    constexpr std::size_t chunk = 64;
+    std::uint64_t word = 0;
+    access::apply(q, [&](const auto& ... m) {
+        constexpr bool uniform = all_true_v<std::is_same_v<std::decay_t<decltype(unwrap(m))>, T>...>;
+#if defined(__GNUC__)
+        if constexpr (uniform && simd::vectorizable_v<T>)
+        {
+            using L = typename simd::lane<T>::type;
+            using V = typename simd::vec<L>::type;
+            using M = decltype(op{}(V{}, V{}));
+            constexpr std::size_t lanes = simd::width / sizeof(L);
+            constexpr std::size_t vectors = chunk / lanes;
+            if (n == chunk)
+            {
+                M acc[vectors];
+                for (auto& a : acc) a = conjunction ? ~M{} : M{};
+                auto accumulate = [&](const T& member) {
+                    L l;
+                    std::memcpy(&l, &member, sizeof(L));
+                    const V needle = V{} + l;
+                    for (std::size_t k = 0; k != vectors; ++k)
+                    {
+                        V v;
+                        std::memcpy(&v, rows + k * lanes, simd::width);
+                        if constexpr (conjunction) acc[k] &= op{}(needle, v); else acc[k] |= op{}(needle, v);
+                    }
+                };
+                each([&](const auto& member) { accumulate(unwrap(member)); }, m...);
+                for (std::size_t k = 0; k != vectors; ++k)
+                {
+                    for (std::size_t j = 0; j != lanes; ++j)
+                    {
+                        word |= std::uint64_t{acc[k][j] != 0} << (k * lanes + j);
+                    }
+                }
+                return;
+            }
+        }
+#endif
+        unsigned char hits[chunk];
+        for (std::size_t i = 0; i != n; ++i) hits[i] = conjunction;
+        auto accumulate = [&](const auto& member) {
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                const bool hit = op{}(member, rows[i]);
+                if constexpr (conjunction) hits[i] &= hit; else hits[i] |= hit;
+            }
+        };
+        each([&](const auto& member) { accumulate(unwrap(member)); }, m...);
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            word |= std::uint64_t{hits[i]} << i;
+        }
+    });
+    if constexpr (kind == quantifier::none)
+    {
+        word = ~word & (n == chunk ? ~std::uint64_t{} : (std::uint64_t{1} << n) - 1);
+    }
+    return word;
+}
+}
+
+// Evaluates column[i] F q, e.g. column[i] == any_of(A, B, C) for
+// F = std::equal_to<>, for every row i in [0, n), and sets bit i % 64 of
+// bits[i / 64] to the result. bits must have room for (n + 63) / 64 words.
+// F is one of std::equal_to, std::not_equal_to, std::less, std::less_equal,
+// std::greater or std::greater_equal, and q an any_of, all_of or none_of.
+template <typename F, typename T, typename Q>
+void select_bits(const T* column, std::size_t n, F, const Q& q, std::uint64_t* bits)
+{
+    constexpr std::size_t chunk = 64;
+    for (std::size_t first = 0; first < n; first += chunk)
+    {
+        bits[first / chunk] = internal::select_chunk<F>(column + first, n - first < chunk ? n - first : chunk, q);
+    }
+}
+
+// Evaluates column[i] F q like select_bits(), and writes the indexes i for
+// which it is true to out, in ascending order. Returns the number of indexes
+// written.
+template <typename F, typename T, typename Q, typename Index>
+std::size_t select_indices(const T* column, std::size_t n, F, const Q& q, Index* out)
+{
+    constexpr std::size_t chunk = 64;
+    std::size_t count = 0;
+    for (std::size_t first = 0; first < n; first += chunk)
+    {
+        auto word = internal::select_chunk<F>(column + first, n - first < chunk ? n - first : chunk, q);
+        while (word)
+        {
+            out[count++] = static_cast<Index>(first + static_cast<std::size_t>(internal::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+    return count;
+}
+
+}
+
+#endif
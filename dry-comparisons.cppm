@@ -0,0 +1,51 @@
+// The dry_comparisons module, for C++20 compilers and build systems that
+// support named modules, e.g. CMake 3.28 or later with the
+// DRY_COMPARISONS_MODULE option. It exports the same names as
+// dry-comparisons.hpp. Configuration macros, e.g.
+// DRY_COMPARISONS_SEARCH_THRESHOLD, apply when the module is built.
+module;
+
+#include "dry-comparisons.hpp"
+
+export module dry_comparisons;
+
+export namespace rollbear {
+using rollbear::any_of;
+using rollbear::all_of;
+using rollbear::none_of;
+using rollbear::any_of_c;
+using rollbear::all_of_c;
+using rollbear::none_of_c;
+using rollbear::count_of;
+using rollbear::at_least;
+using rollbear::at_most;
+using rollbear::exactly;
+using rollbear::one_of;
+using rollbear::first_match;
+using rollbear::compare_exchange;
+#if defined(__cpp_lib_three_way_comparison)
+using rollbear::ordering_summary;
+#endif
+using rollbear::sorted_t;
+using rollbear::sorted;
+using rollbear::any_of_range;
+using rollbear::all_of_range;
+using rollbear::none_of_range;
+using rollbear::endpoint;
+using rollbear::interval;
+using rollbear::between;
+using rollbear::half_open;
+using rollbear::strictly_between;
+using rollbear::text_position;
+using rollbear::text_pattern;
+using rollbear::starts_with;
+using rollbear::ends_with;
+using rollbear::contains;
+using rollbear::icase_string;
+using rollbear::icase;
+using rollbear::adaptive_any_of;
+using rollbear::pure_comparison;
+using rollbear::select_bits;
+using rollbear::select_indices;
+using rollbear::operator<<;
+}
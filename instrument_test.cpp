@@ -0,0 +1,207 @@
+#define DRY_COMPARISONS_INSTRUMENT
+#include "dry-comparisons.hpp"
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <new>
+#include <cstdlib>
+
+using rollbear::all_of;
+using rollbear::any_of;
+using rollbear::none_of;
+
+#define REQUIRE(...) [&](){if (__VA_ARGS__) {;} else { throw #__VA_ARGS__;}}()
+
+static_assert(2 == any_of(1, 2), "constant expressions are not counted");
+
+// While set, every allocation fails, to check that comparisons do not
+// terminate when their counters cannot be allocated.
+static bool fail_allocations = false;
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC warns about free() of memory from operator new, not knowing that
+// this is the operator new that allocated it.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(std::size_t size)
+{
+    if (fail_allocations) throw std::bad_alloc();
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+rollbear::instrumentation::site_statistics statistics_for(unsigned line)
+{
+    for (auto& s : rollbear::instrumentation::snapshot())
+    {
+        if (s.line == line && std::string(s.file).find("instrument_test") != std::string::npos) return s;
+    }
+    return {"", line, 0, 0, {}, 0};
+}
+
+constexpr unsigned thread_line = __LINE__; bool compare_in_thread(int i) { return i == any_of(-1, -2); }
+
+int main()
+{
+  struct test {
+    const char* name;
+    void (*test_func)();
+  };
+  test tests[] = {
+    {
+        "comparisons are counted per call site",
+        []{
+            unsigned line = 0;
+            for (int i = 0; i != 10; ++i)
+            {
+                line = __LINE__; const bool eq = i == any_of(1, 2, 3); const bool ne = i != any_of(1, 2, 3);
+                REQUIRE(eq != ne);
+            }
+            auto s = statistics_for(line);
+            REQUIRE(s.calls == 20);
+            REQUIRE(s.decided_by.size() == 3);
+            REQUIRE(s.decided_by[0] == 2);
+            REQUIRE(s.decided_by[1] == 2);
+            REQUIRE(s.decided_by[2] == 2);
+            REQUIRE(s.undecided == 14);
+            // 10 ==, of which 7 compare all 3, and 10 !=, of which 7 compare all 3
+            REQUIRE(s.comparisons == 2 * (1 + 2 + 3 + 7 * 3));
+        }
+    },
+    {
+        "all_of is decided by the first false",
+        []{
+            const unsigned line = __LINE__; auto q = all_of(1, 2, 1);
+            REQUIRE(!(q == 1));
+            REQUIRE(q);
+            auto s = statistics_for(line);
+            REQUIRE(s.calls == 2);
+            REQUIRE(s.comparisons == 2 + 3);
+            REQUIRE(s.decided_by.size() == 2);
+            REQUIRE(s.decided_by[1] == 1);
+            REQUIRE(s.undecided == 1);
+        }
+    },
+    {
+        "calls are counted at the site of the callables",
+        []{
+            const unsigned line = __LINE__; auto q = none_of{[](int x) { return x < 0;}, [](int x) { return x > 9;}};
+            REQUIRE(q(5));
+            REQUIRE(!q(10));
+            auto s = statistics_for(line);
+            REQUIRE(s.calls == 2);
+            REQUIRE(s.comparisons == 4);
+        }
+    },
+    {
+        "counts from all threads are summed",
+        []{
+            auto work = [] {
+                for (int i = 0; i != 1000; ++i)
+                {
+                    if (compare_in_thread(i)) std::abort();
+                }
+            };
+            std::thread t1(work);
+            std::thread t2(work);
+            t1.join();
+            t2.join();
+            auto s = statistics_for(thread_line);
+            REQUIRE(s.calls == 2000);
+            REQUIRE(s.comparisons == 4000);
+        }
+    },
+    {
+        "counting quantifiers are counted at the call site, and decided when the count is known",
+        []{
+            const unsigned line = __LINE__; auto q = rollbear::at_least<2>(1, 2, 1, 3);
+            REQUIRE(1 == q);
+            REQUIRE(!(3 == q));
+            auto s = statistics_for(line);
+            REQUIRE(s.calls == 2);
+            REQUIRE(s.comparisons == 3 + 3);
+            REQUIRE(s.decided_by.size() == 3);
+            REQUIRE(s.decided_by[2] == 2);
+            const unsigned one_line = __LINE__; REQUIRE(2 == rollbear::one_of(1, 2, 3));
+            REQUIRE(statistics_for(one_line).calls == 1);
+        }
+    },
+    {
+        "counting quantifiers of more than 8 members are counted at ?:0",
+        []{
+            auto q = rollbear::exactly<1>(1, 2, 3, 4, 5, 6, 7, 8, 9);
+            REQUIRE(9 == q);
+            for (auto& s : rollbear::instrumentation::snapshot())
+            {
+                if (s.line != 0 || std::string(s.file) != "?") continue;
+                REQUIRE(s.calls == 1);
+                REQUIRE(s.comparisons == 9);
+                return;
+            }
+            REQUIRE(!"counted");
+        }
+    },
+    {
+        "comparisons are dropped, not fatal, when counters cannot be allocated",
+        []{
+            int three = 3;
+            const auto before = rollbear::instrumentation::dropped();
+            fail_allocations = true;
+            const unsigned line = __LINE__; const bool r = three == any_of(4, 3);
+            fail_allocations = false;
+            REQUIRE(r);
+            REQUIRE(rollbear::instrumentation::dropped() == before + 1);
+            REQUIRE(statistics_for(line).calls == 0);
+        }
+    },
+    {
+        "dump writes one line per call site",
+        []{
+            const unsigned line = __LINE__; REQUIRE(3 == any_of(3, 4));
+            std::ostringstream os;
+            rollbear::instrumentation::dump(os);
+            std::ostringstream expected;
+            expected << ':' << line << " calls=1 comparisons=1 decided_by=[1] undecided=0\n";
+            REQUIRE(os.str().find(expected.str()) != std::string::npos);
+        }
+    },
+  };
+  int failures = 0;
+  for (auto& t : tests)
+  {
+    try {
+      std::cout << std::setw(60) << std::left << t.name << ' ';
+      t.test_func();
+      std::cout << "pass\n";
+    }
+    catch (const char* m)
+    {
+      ++failures;
+      std::cout << "failed: " << m << '\n';
+    }
+  }
+  if (!failures)
+  {
+    std::puts("\ncool!");
+  }
+  else
+  {
+    std::puts("\nbummer!");
+  }
+  return failures;
+}
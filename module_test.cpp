@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+import dry_comparisons;
+
+using rollbear::all_of;
+using rollbear::any_of;
+using rollbear::none_of;
+
+#define REQUIRE(...) [&](){if (__VA_ARGS__) {;} else { throw #__VA_ARGS__;}}()
+
+static_assert(3 == any_of(1, 3, 5));
+static_assert(3 < all_of(4, 5));
+static_assert(3 == none_of(4, 5));
+static_assert(3 == rollbear::any_of_c<1, 3>);
+static_assert(3 == any_of(rollbear::between(1, 2), rollbear::half_open(3, 4)));
+static_assert(3 == rollbear::at_least<2>(3, 1, 3));
+static_assert(any_of(3, 5).find_first(5) == 1);
+static_assert((all_of(3, 5) <=> 4) != 0);
+static_assert(std::string_view("/api/x") == any_of(rollbear::starts_with("/v2/"), rollbear::starts_with("/api/")));
+static_assert(std::string_view("HOST") == any_of(rollbear::icase("host"), rollbear::icase("accept")));
+
+int main()
+{
+  try {
+    const std::vector<int> v{1, 3, 5};
+    REQUIRE(3 == rollbear::any_of_range(v));
+    REQUIRE(std::string("b") == any_of("a", "b"));
+    REQUIRE(bool(all_of([](int x) { return x > 0; }, [](int x) { return x < 10; })(3)));
+    std::ostringstream os;
+    os << any_of(1, 2) << ' ' << rollbear::none_of_range(v);
+    REQUIRE(os.str() == "any_of{1,2} none_of{1,3,5}");
+  }
+  catch (const char* m)
+  {
+    std::printf("failed: %s\n\nbummer!\n", m);
+    return 1;
+  }
+  std::puts("cool!");
+}
@@ -1,9 +1,22 @@
 #include "dry-comparisons.hpp"
+#include "dry-comparisons-parallel.hpp"
+#include "dry-comparisons-coro.hpp"
 #include <cstdio>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <limits>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 template <template <typename ...> class, typename ...>
   struct is_detected_ : std::false_type {};
@@ -20,6 +33,17 @@ template <template <typename ...> class D, typename ... A>
 using rollbear::all_of;
 using rollbear::any_of;
 using rollbear::none_of;
+using rollbear::all_of_c;
+using rollbear::any_of_c;
+using rollbear::none_of_c;
+using rollbear::all_of_range;
+using rollbear::any_of_range;
+using rollbear::none_of_range;
+using rollbear::adaptive_any_of;
+using rollbear::at_least;
+using rollbear::at_most;
+using rollbear::exactly;
+using rollbear::one_of;
 
 constexpr int x = 3;
 constexpr const char* nullstr = nullptr;
@@ -43,6 +67,8 @@ static_assert(!(x > any_of(4,3,5,6)));
 
 static_assert(x >= any_of(0,3,1,2));
 static_assert(!(x >= any_of(4,5,6)));
+// The layout doesn't depend on the vector width the target flags select.
+static_assert(alignof(any_of<int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int>) == alignof(int));
 
 static_assert(any_of{add<1>, add<2>, add<3>}(-2) == 0);
 static_assert(!(rollbear::any_of{add<1>, add<2>, add<3>}(-2) == 3));
@@ -130,12 +156,35 @@ static_assert(!all_of{gt(3), aborts}(2), "all_of short cirquits calls");
 static_assert(any_of{gt(1), aborts}(2), "any_of short cirquits calls");
 //static_assert(none_of{gt(3), aborts}(2), "none_of short cirquits calls");
 static_assert(!none_of{gt(1), aborts}(2), "none_of short cirquits calls");
+static_assert(at_least<1>(gt(1), aborts)(2), "at_least stops when reached");
+static_assert(!at_most<1>(gt(1), gt(0), aborts)(2), "at_most stops when exceeded");
+static_assert(!exactly<3>(gt(3), aborts, aborts)(2), "exactly stops when out of reach");
+static_assert(!one_of(gt(1), gt(0), aborts)(2), "one_of stops at the second");
+static_assert(at_most<1>(gt(3), gt(2), aborts)(2), "at_most stops when too few are left");
+
+static_assert(3 == at_least<2>(3, 1, 3));
+static_assert(!(3 == at_least<2>(3, 1, 2)));
+static_assert(3 != at_least<2>(3, 1, 2));
+static_assert(3 == at_most<1>(3, 1, 2));
+static_assert(3 == exactly<0>(1, 2));
+static_assert(3 == one_of(3, 1, 2));
+static_assert(3 != one_of(3, 3, 2));
+static_assert(3 < exactly<2>(4, 5, 1));
+static_assert(at_least<2>(4, 5, 1) > 3);
+static_assert(0 == at_least<0>());
+static_assert(bool(one_of(true, false, 0)));
+static_assert(!bool(one_of(true, 1, false)));
+static_assert(!bool(at_least<3>(1, 2)));
+static_assert(is_detected_v<print_result_type, decltype(one_of(1, 2))>);
+static_assert(!is_detected_v<print_result_type, decltype(one_of(1, nonprintable{}))>);
+static_assert(!is_detected_v<any_of_eq<decltype(one_of(nonprintable{}))>::type, int>);
 
 constexpr auto not_null = [](auto&& v) { return v != nullptr;};
 
-static_assert(!is_callable_v<decltype(all_of{not_null}), std::unique_ptr<int>>, "non-copyable rvalues are disallowed");
-static_assert(!is_callable_v<decltype(any_of{not_null}), std::unique_ptr<int>>, "non-copyable rvalues are disallowed");
-static_assert(!is_callable_v<decltype(none_of{not_null}), std::unique_ptr<int>>, "non-copyable rvalues are disallowed");
+static_assert(is_callable_v<decltype(all_of{not_null}), std::unique_ptr<int>>, "move only rvalues are moved");
+static_assert(is_callable_v<decltype(any_of{not_null}), std::unique_ptr<int>>, "move only rvalues are moved");
+static_assert(is_callable_v<decltype(none_of{not_null}), std::unique_ptr<int>>, "move only rvalues are moved");
+static_assert(sizeof(any_of{std::negate<>{}, std::logical_not<>{}}(0)) == sizeof(int), "the argument is stored once, and empty callables take no space");
 
 template <typename T>
 struct throwing
@@ -232,8 +281,577 @@ static_assert(noexcept(any_of_ident_throw(3)));
 static_assert(!noexcept(any_of_ident_throw(3) > 0));
 #endif
 
+static_assert(x == any_of(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19));
+static_assert(x < all_of(4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23));
+static_assert(x != none_of(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19));
+static_assert(sizeof(any_of<int,int,int>) == 3*sizeof(int));
+
+// Packs larger than DRY_COMPARISONS_FOLD_LIMIT, and than the fold
+// expressions Clang accepts, with each kind of storage.
+constexpr std::size_t large = 300;
+template <std::size_t I>
+using mixed_t = std::conditional_t<I % 3 == 0, int, std::conditional_t<I % 3 == 1, long, short>>;
+template <template <typename ...> class Q, std::size_t ... I>
+constexpr auto large_mixed(std::index_sequence<I...>)
+{
+    return Q<mixed_t<I>...>(static_cast<mixed_t<I>>(I)...);
+}
+template <std::size_t ... I>
+constexpr std::array<int, sizeof...(I)> iota(std::index_sequence<I...>)
+{
+    return {{static_cast<int>(I)...}};
+}
+constexpr auto large_values = iota(std::make_index_sequence<large>{});
+template <std::size_t ... I>
+constexpr auto large_references(std::index_sequence<I...>)
+{
+    return any_of(large_values[I]...);
+}
+constexpr char letters[] = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz";
+template <std::size_t ... I>
+constexpr auto large_strings(std::index_sequence<I...>)
+{
+    return any_of(std::string_view(letters + I % 26, 1 + I / 26)...);
+}
+constexpr auto large_indexes = std::make_index_sequence<large>{};
+static_assert(299 == large_mixed<any_of>(large_indexes));
+static_assert(!(300 == large_mixed<any_of>(large_indexes)));
+static_assert(-1 < large_mixed<all_of>(large_indexes));
+static_assert(!(0 < large_mixed<all_of>(large_indexes)));
+static_assert(300 == large_mixed<none_of>(large_indexes));
+static_assert(!bool(large_mixed<all_of>(large_indexes)));
+static_assert(bool(large_mixed<any_of>(large_indexes)));
+static_assert(150 == large_references(large_indexes));
+static_assert(sizeof(large_references(large_indexes)) == large * sizeof(int*), "an array of pointers");
+static_assert(std::string_view("xyzabcdefgh") == large_strings(large_indexes));
+static_assert(!(std::string_view("xyzabcdefghi") == large_strings(large_indexes)));
+
+enum state { S0, S1, S2, S3, S40 = 40, S100 = 100 };
+
+static_assert(S1 == any_of_c<S1, S3>);
+static_assert(!(S2 == any_of_c<S1, S3>));
+static_assert(S2 != any_of_c<S1, S3>);
+static_assert(S40 == any_of_c<S1, S3, S40>, "bit mask");
+static_assert(!(S0 == any_of_c<S1, S3, S40>), "bit mask");
+static_assert(S100 == any_of_c<S1, S100>, "linear");
+static_assert(!(S40 == any_of_c<S1, S100>), "linear");
+static_assert(x == any_of_c<1,2,3,4,5>, "range");
+static_assert(!(x == any_of_c<4,5,6,7,8>), "range");
+static_assert(x == any_of_c<1,100,1000,3,100000,1000000,-7>, "hash");
+static_assert(!(x == any_of_c<1,100,1000,4,100000,1000000,-7>), "hash");
+
+template <typename Q, typename U>
+using find_first_type = decltype(std::declval<const Q&>().find_first(std::declval<const U&>()));
+template <typename Q>
+using which_type = decltype(std::declval<const Q&>().which());
+template <typename Q, typename P>
+using by_type = decltype(std::declval<const Q&>().by(std::declval<const P&>()));
+
+struct item
+{
+    int id;
+    short weight;
+    constexpr int twice() const { return 2 * id; }
+    int loud();
+};
+
+template <std::size_t ... I>
+constexpr bool constant_set_searches_agree(std::index_sequence<I...>)
+{
+    using set = rollbear::internal::constant_set<int, int(I * I * 37 % 1009)...>;
+    for (int u = -1; u != 1100; ++u)
+    {
+        const bool member = set::linear_search(u);
+        if (set::tree_search(u) != member) return false;
+        if (set::sorted_search(u) != member) return false;
+        if (set::table.found && set::hash_search(u) != member) return false;
+        if (set::contains(u) != member) return false;
+        const std::size_t index = set::linear_index(u);
+        if ((index != set::size) != member) return false;
+        if (set::tree_index(u) != index) return false;
+        if (set::sorted_index(u) != index) return false;
+        if (set::table.found && set::hash_index(u) != index) return false;
+        if (set::index_of(u) != index) return false;
+    }
+    return true;
+}
+static_assert(constant_set_searches_agree(std::make_index_sequence<5>{}));
+static_assert(constant_set_searches_agree(std::make_index_sequence<17>{}));
+static_assert(constant_set_searches_agree(std::make_index_sequence<100>{}));
+static_assert(any_of_c<S1, S3, S40>.find_first(S40) == 2, "bit mask");
+static_assert(any_of_c<S1, S3, S40>.find_first(S0) == 3, "bit mask");
+static_assert(any_of_c<3, 1, 2, 1>.find_first(1) == 1, "range");
+static_assert(any_of_c<1,100,1000,3,100000,1000000,-7>.find_first(-7) == 6, "hash");
+static_assert(any_of_c<1,100,1000,3,100000,1000000,-7>.find_first(4) == 7, "hash");
+static_assert(any_of_c<3L, 4>.find_first(4) == 1, "mixed types are compared one by one");
+static_assert(any_of(3, 5, 7).find_first(5) == 1);
+static_assert(all_of(3, 5, 7).find_first(4) == 3);
+static_assert(none_of("GET", "PUT").find_first(std::string_view("PUT")) == 1);
+static_assert(!is_detected_v<find_first_type, decltype(any_of(1, 2)), nonprintable>);
+static_assert(any_of(0, 4, 0).which().index == 1);
+static_assert(any_of(0, 4, 0).which().value == 4);
+static_assert(all_of(0, 0.0).which().index == 2);
+static_assert(std::is_same_v<decltype(any_of(0, 4L).which().value), long>);
+static_assert(!is_detected_v<which_type, decltype(any_of(1, nonprintable{}))>);
+static_assert(all_of(item{1, 2}, item{3, 4}).by(&item::id) < 4);
+static_assert(any_of(item{1, 2}, item{3, 4}).by(&item::twice) == 6);
+static_assert(none_of(item{1, 2}, item{3, 4}).by([](const item& i) { return i.id + i.weight; }) == 5);
+static_assert(one_of(item{1, 2}, item{3, 2}, item{5, 6}).by(&item::weight) == 6);
+static_assert(std::is_same_v<decltype(any_of(item{}, item{}).by(&item::id)), any_of<const int&, const int&>>);
+static_assert(std::is_same_v<decltype(any_of(item{}, item{}).by(&item::twice)), any_of<int, int>>);
+static_assert(!is_detected_v<by_type, decltype(any_of(item{})), int (item::*)()>, "not const");
+static_assert(!is_detected_v<by_type, decltype(any_of(1, 2)), int item::*>);
+static_assert(is_detected_v<by_type, any_of_range<item>, short item::*>);
+static_assert(!is_detected_v<by_type, any_of_range<item>, int (item::*)() const>, "only data members");
+constexpr item catalogue[] = {{1, 2}, {3, 4}, {5, 6}};
+static_assert(any_of_range(catalogue).by(&item::id) == 3);
+static_assert(!(any_of_range(catalogue).by(&item::id) == 4));
+static_assert(all_of_range(catalogue).by(&item::weight) < 7);
+static_assert(none_of_range(catalogue).by(&item::weight) == 3);
+static_assert(!is_detected_v<by_type, decltype(any_of_range(catalogue).by(&item::id)), int item::*>,
+              "projections do not nest");
+#if defined(__cpp_lib_three_way_comparison)
+static_assert((any_of(1, 3, 5) <=> 3) == 0);
+static_assert((any_of(1, 3, 5) <=> 0) > 0);
+static_assert((all_of(1, 3, 5) <=> 6) < 0);
+static_assert(!((all_of(1, 3, 5) <=> 3) <= 0));
+static_assert((none_of(1, 3, 5) <=> 4) == 0);
+static_assert((4 <=> all_of(1, 3)) > 0);
+static_assert((any_of_c<1, 3, 5> <=> 5) >= 0);
+static_assert((all_of_c<1, 3, 5> <=> 0) > 0);
+static_assert((any_of(std::string_view("GET"), std::string_view("PUT")) <=> std::string_view("HEAD")) < 0);
+#endif
+static_assert(x < any_of_c<1,2,4>);
+static_assert(!(x < any_of_c<1,2,3>));
+static_assert(x >= any_of_c<3,4,5>);
+static_assert(x == all_of_c<3,3,3>);
+static_assert(!(x == all_of_c<3,4,3>));
+static_assert(x != all_of_c<3,4,3>);
+static_assert(x < all_of_c<4,5,6>);
+static_assert(!(x <= all_of_c<4,5,2>));
+static_assert(x == none_of_c<1,2,4>);
+static_assert(!(x == none_of_c<1,3,4>));
+static_assert(x > none_of_c<3,4,5>);
+static_assert(x == any_of_c<3L, 4>, "mixed types are compared one by one");
+static_assert(bool(any_of_c<0, 1>));
+static_assert(!bool(all_of_c<0, 1>));
+static_assert(std::is_empty_v<std::remove_cv_t<decltype(any_of_c<1,2,3>)>>);
+
+static_assert(std::string_view("PUT") == any_of("GET", "PUT", "POST"));
+static_assert(!(std::string_view("PUX") == any_of("GET", "PUT", "POST")));
+static_assert(std::string_view("PUX") == none_of("GET", "PUT", "POST"));
+static_assert(std::string_view("GET") == all_of("GET", std::string_view("GET")));
+static_assert(!(std::string_view("GET") != any_of("GET", "", "POST")));
+static_assert(std::string_view("GET") != all_of("GET", "", "POST"));
+static_assert(std::string_view("") == any_of("GET", "", "POST"));
+static_assert(std::string_view("a") < all_of("b", "c"), "relational operators are folded");
+static_assert(std::string_view("Content-Type") == rollbear::icase("content-type"));
+static_assert(std::string_view("Content-Typo") != rollbear::icase("content-type"));
+static_assert(std::string_view("[") != rollbear::icase("{"), "only letters are folded");
+constexpr auto header_names = any_of(rollbear::icase("content-type"), rollbear::icase("Content-Length"),
+                                     rollbear::icase("HOST"), rollbear::icase("accept"));
+static_assert(std::is_base_of_v<rollbear::internal::icase_storage<4>, std::remove_cv_t<decltype(header_names)>>);
+static_assert(std::string_view("CONTENT-LENGTH") == header_names && std::string_view("host") == header_names);
+static_assert(std::string_view("hosts") != header_names && std::string_view("") != header_names);
+static_assert(std::string_view("GET") == all_of(rollbear::icase("get"), rollbear::icase("Get")));
+
+using rollbear::between;
+using rollbear::half_open;
+using rollbear::strictly_between;
+
+static_assert(x == between(1, 3));
+static_assert(3 == between(3, 3));
+static_assert(!(x == half_open(1, 3)));
+static_assert(x != strictly_between(3, 5));
+static_assert(x == strictly_between(2.5, 3.5));
+static_assert(!(std::numeric_limits<double>::quiet_NaN() == between(-1.0, 1.0)));
+static_assert(x == any_of(between(1, 2), between(3, 5)));
+static_assert(x == none_of(half_open(1, 3), strictly_between(3, 5)));
+static_assert(x == all_of(between(1, 3), half_open(3, 4)));
+static_assert(x != all_of(between(1, 3), half_open(4, 5)));
+static_assert(!is_detected_v<any_of_eq<rollbear::interval<int>>::type, rollbear::interval<int>>,
+              "intervals are not values");
+
+constexpr auto rate_classes = any_of(between(100, 200), between(1, 5), between(4, 9), between(7, 7),
+                                     between(300, 299), between(10, 20));
+static_assert(std::is_base_of_v<rollbear::internal::interval_storage<rollbear::interval<int>, 6>,
+                                std::remove_cv_t<decltype(rate_classes)>>);
+static_assert(1 == rate_classes && 9 == rate_classes && 10 == rate_classes && 200 == rate_classes);
+static_assert(0 != rate_classes && 250 != rate_classes && 299 != rate_classes && 201 != rate_classes);
+static_assert(5 == none_of(strictly_between(0, 5), strictly_between(5, 9), strictly_between(10, 11),
+                           strictly_between(2, 4), strictly_between(12, 13)));
+static_assert(5 == any_of(half_open(0, 5), half_open(5, 9), half_open(10, 11),
+                          half_open(2, 4), half_open(12, 13)));
+
+using rollbear::starts_with;
+using rollbear::ends_with;
+using rollbear::contains;
+static_assert(std::string_view("/api/users") == starts_with("/api/"));
+static_assert(std::string_view("/api") != starts_with("/api/"));
+static_assert("report.csv" == any_of(ends_with(".txt"), ends_with(".csv")));
+static_assert("a needle here" == contains("needle"));
+
+constexpr auto routes = any_of(starts_with("/api/"), starts_with("/v2/"), starts_with("/static/"),
+                               starts_with("/api/admin/"), ends_with(".json"), ends_with("/health"));
+static_assert(std::is_base_of_v<rollbear::internal::pattern_storage<6>, std::remove_cv_t<decltype(routes)>>);
+static_assert(std::string_view("/api/users") == routes && std::string_view("/static/a.png") == routes);
+static_assert(std::string_view("/x/y.json") == routes && std::string_view("/db/health") == routes);
+static_assert(std::string_view("/x/api/") != routes && std::string_view("/x/y.jsonp") != routes);
+static_assert(std::string_view("") != routes && std::string_view("/v2") != routes);
+constexpr auto logs = none_of(contains("error"), contains("fatal"), contains("panic"), contains("rror:"),
+                              starts_with("#"));
+static_assert(std::string_view("all is well") == logs && std::string_view("") == logs);
+static_assert(std::string_view("an error: x") != logs && std::string_view("#comment") != logs);
+static_assert(std::string_view("x #comment") == logs && std::string_view("kernel panic") != logs);
+
+constexpr std::array<int, 4> odd{1,3,5,7};
+static_assert(x == any_of_range(odd));
+static_assert(x == any_of_range(odd, rollbear::sorted));
+static_assert(!(x == any_of_range(odd.data(), 1)));
+static_assert(x != any_of_range(odd.data(), 1, rollbear::sorted));
+static_assert(x < any_of_range(odd, rollbear::sorted));
+static_assert(x <= all_of_range(odd.data() + 1, 3));
+static_assert(x > none_of_range(odd.data() + 1, 3, rollbear::sorted));
+static_assert(!(x < all_of_range(odd)));
+static_assert(bool(all_of_range(odd)));
+static_assert(!bool(any_of_range(odd.data(), 0)));
+static_assert(bool(all_of_range(odd.data(), 0)));
+static_assert(bool(none_of_range(odd.data(), 0)));
+static_assert(!is_detected_v<print_result_type, any_of_range<nonprintable>>);
+
+// The left quantifier is the outer one, so all_of(a...) == any_of(b...) is
+// whether every a is among b...
+static_assert(all_of(1, 2) == any_of(3, 2, 1));
+static_assert(!(all_of(1, 4) == any_of(3, 2, 1)));
+static_assert(any_of(1, 4) == any_of(3, 2, 1));
+static_assert(any_of(4, 5) != any_of(3, 2, 1));
+static_assert(any_of(1, 4) == none_of(3, 2, 1));
+static_assert(all_of(4, 5) == none_of(3, 2, 1));
+static_assert(none_of(4, 5) == any_of(3, 2, 1));
+static_assert(any_of(0, 1) == any_of_range(odd));
+static_assert(all_of(3, 7) == any_of_range(odd, rollbear::sorted));
+static_assert(any_of(0, 2) == none_of_range(odd));
+static_assert(any_of_range(odd) == any_of(0, 1));
+static_assert(all_of(std::string_view("GET"), std::string_view("PUT")) == any_of("GET", "PUT", "POST"));
+static_assert(!(any_of(std::string_view("PUX"), std::string_view("GEX")) == any_of("GET", "PUT", "POST")));
+
+struct counted
+{
+    static inline int copies = 0;
+    static inline int moves = 0;
+    explicit counted(int v) : value(v) {}
+    counted(const counted& c) : value(c.value) { ++copies; }
+    counted(counted&& c) noexcept : value(c.value) { ++moves; }
+    int value;
+};
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define COROUTINES 1
+rollbear::coro::local_executor executor;
+int coroutines_finished = 0;
+
+rollbear::coro::task<bool> after(int yields, bool value)
+{
+    for (int i = 0; i != yields; ++i) co_await executor.schedule();
+    ++coroutines_finished;
+    co_return value;
+}
+
+rollbear::coro::task<bool> throws_after(int yields)
+{
+    for (int i = 0; i != yields; ++i) co_await executor.schedule();
+    throw std::runtime_error("oops");
+    co_return false;
+}
+#endif
+
 #define REQUIRE(...) [&](){if (__VA_ARGS__) {;} else { throw #__VA_ARGS__;}}()
 
+template <typename T, typename Op>
+bool reference_any(const std::initializer_list<T>& vs, Op op, T u)
+{
+    bool r = false;
+    for (auto& v : vs) r = r || op(v, u);
+    return r;
+}
+
+template <typename T, typename Op>
+bool reference_all(const std::initializer_list<T>& vs, Op op, T u)
+{
+    bool r = true;
+    for (auto& v : vs) r = r && op(v, u);
+    return r;
+}
+
+template <typename T, typename ... V>
+void require_same_as_fold(T u, V ... v)
+{
+    const auto vs = {T(v)...};
+    const auto a = any_of{T(v)...};
+    const auto l = all_of{T(v)...};
+    const auto n = none_of{T(v)...};
+    REQUIRE((a == u) == reference_any(vs, std::equal_to<>{}, u));
+    REQUIRE((a != u) == reference_all(vs, std::not_equal_to<>{}, u));
+    REQUIRE((a < u) == reference_any(vs, std::less<>{}, u));
+    REQUIRE((a <= u) == reference_any(vs, std::less_equal<>{}, u));
+    REQUIRE((a > u) == reference_any(vs, std::greater<>{}, u));
+    REQUIRE((a >= u) == reference_any(vs, std::greater_equal<>{}, u));
+    REQUIRE((l == u) == reference_all(vs, std::equal_to<>{}, u));
+    REQUIRE((l != u) == reference_any(vs, std::not_equal_to<>{}, u));
+    REQUIRE((l < u) == reference_all(vs, std::less<>{}, u));
+    REQUIRE((l <= u) == reference_all(vs, std::less_equal<>{}, u));
+    REQUIRE((l > u) == reference_all(vs, std::greater<>{}, u));
+    REQUIRE((l >= u) == reference_all(vs, std::greater_equal<>{}, u));
+    REQUIRE((n == u) == !reference_any(vs, std::equal_to<>{}, u));
+    REQUIRE((n != u) == !reference_all(vs, std::not_equal_to<>{}, u));
+    REQUIRE((n < u) == !reference_any(vs, std::less<>{}, u));
+    REQUIRE((n <= u) == !reference_any(vs, std::less_equal<>{}, u));
+    REQUIRE((n > u) == !reference_any(vs, std::greater<>{}, u));
+    REQUIRE((n >= u) == !reference_any(vs, std::greater_equal<>{}, u));
+}
+
+template <typename U, typename ... T>
+void require_counts_same_as_loop(const U& u, const T& ... t)
+{
+    std::size_t eq = 0, gt = 0, le = 0, ge = 0;
+    ((eq += t == u, gt += t > u, le += t <= u, ge += t >= u), ...);
+    REQUIRE((u == at_least<2>(t...)) == (eq >= 2));
+    REQUIRE((u != at_least<2>(t...)) == (eq < 2));
+    REQUIRE((at_most<1>(t...) == u) == (eq <= 1));
+    REQUIRE((u == exactly<3>(t...)) == (eq == 3));
+    REQUIRE((u != exactly<3>(t...)) == (eq != 3));
+    REQUIRE((u == one_of(t...)) == (eq == 1));
+    REQUIRE((u < at_least<4>(t...)) == (gt >= 4));
+    REQUIRE((at_most<2>(t...) <= u) == (le <= 2));
+    REQUIRE((u <= exactly<0>(t...)) == (ge == 0));
+    REQUIRE((exactly<5>(t...) > u) == (gt == 5));
+}
+
+#if defined(__cpp_lib_three_way_comparison)
+template <typename Q, typename U>
+void require_ordering_same_as_operators(const Q& q, const U& u)
+{
+    REQUIRE(((q <=> u) == 0) == (q == u));
+    REQUIRE(((q <=> u) != 0) == (q != u));
+    REQUIRE(((q <=> u) < 0) == (q < u));
+    REQUIRE(((q <=> u) <= 0) == (q <= u));
+    REQUIRE(((q <=> u) > 0) == (q > u));
+    REQUIRE(((q <=> u) >= 0) == (q >= u));
+    REQUIRE((0 < (q <=> u)) == (q > u));
+    REQUIRE(((u <=> q) < 0) == (u < q));
+    REQUIRE(((u <=> q) >= 0) == (u >= q));
+}
+
+template <typename U, typename ... T>
+void require_orderings_same_as_operators(const U& u, const T& ... t)
+{
+    require_ordering_same_as_operators(any_of(t...), u);
+    require_ordering_same_as_operators(all_of(t...), u);
+    require_ordering_same_as_operators(none_of(t...), u);
+    if constexpr (sizeof...(T) != 0 && (std::is_same_v<T, U> && ...))
+    {
+        const U values[] = {t...};
+        require_ordering_same_as_operators(any_of_range(values), u);
+        require_ordering_same_as_operators(all_of_range(values), u);
+        require_ordering_same_as_operators(none_of_range(values), u);
+        // A sorted range is ordered, so it holds no NaN.
+        const bool ordered = std::all_of(std::begin(values), std::end(values), [](const U& v) { return v == v; });
+        if (ordered && std::is_sorted(std::begin(values), std::end(values)))
+        {
+            require_ordering_same_as_operators(any_of_range(values, rollbear::sorted), u);
+            require_ordering_same_as_operators(all_of_range(values, rollbear::sorted), u);
+            require_ordering_same_as_operators(none_of_range(values, rollbear::sorted), u);
+        }
+    }
+}
+#endif
+
+template <typename T>
+void require_projected_range_same_as_loop()
+{
+    struct element
+    {
+        char tag;
+        T value;
+        std::int64_t key;
+    };
+    for (std::size_t n = 0; n != 40; ++n)
+    {
+        std::vector<element> v(n);
+        for (std::size_t i = 0; i != n; ++i) v[i] = {'x', static_cast<T>(i % 7), std::int64_t(i)};
+        for (int u = -1; u != 8; ++u)
+        {
+            const T t = static_cast<T>(u);
+            std::size_t eq = 0, lt = 0;
+            for (const auto& e : v)
+            {
+                eq += e.value == t;
+                lt += e.value < t;
+            }
+            REQUIRE((any_of_range(v).by(&element::value) == t) == (eq != 0));
+            REQUIRE((all_of_range(v).by(&element::value) < t) == (lt == n));
+            REQUIRE((none_of_range(v).by(&element::value) < t) == (lt == 0));
+            REQUIRE((t > any_of_range(v).by(&element::value)) == (lt != 0));
+            REQUIRE((any_of_range(v).by(&element::key) == std::int64_t(u)) == (u >= 0 && std::size_t(u) < n));
+#if defined(__cpp_lib_three_way_comparison)
+            REQUIRE(((any_of_range(v).by(&element::value) <=> t) >= 0) == (lt != n));
+#endif
+        }
+    }
+}
+
+template <std::size_t ... I>
+void require_large_same_as_fold(std::index_sequence<I...>)
+{
+    int values[] = {static_cast<int>(I)...};
+    const auto references = any_of(values[I]...);
+    const auto mixed = all_of(static_cast<mixed_t<I>>(values[I])...);
+    for (int u : {-1, 0, 150, 299, 300})
+    {
+        require_same_as_fold(u, static_cast<int>(I)...);
+        REQUIRE((u == references) == (u >= 0 && u < int(large)));
+        REQUIRE((u != references) == !(u >= 0 && u < int(large)));
+        REQUIRE((u > mixed) == (u >= int(large)));
+        REQUIRE((u <= mixed) == (u <= 0));
+    }
+    values[0] = -1;
+    REQUIRE(-1 == references);
+    std::ostringstream expected;
+    expected << "all_of{";
+    for (std::size_t i = 0; i != large; ++i) expected << &","[i == 0] << i;
+    expected << '}';
+    std::ostringstream os;
+    os << mixed;
+    REQUIRE(os.str() == expected.str());
+}
+
+template <typename U, typename ... I>
+void require_intervals_same_as_members(U u, I ... i)
+{
+    const bool in_any = (i.contains(u) || ...);
+    const bool in_all = (i.contains(u) && ...);
+    REQUIRE((u == any_of(i...)) == in_any);
+    REQUIRE((u != any_of(i...)) == !in_any);
+    REQUIRE((u == none_of(i...)) == !in_any);
+    REQUIRE((u != none_of(i...)) == in_any);
+    REQUIRE((u == all_of(i...)) == in_all);
+    REQUIRE((u != all_of(i...)) == !in_all);
+}
+
+template <typename ... P>
+void require_patterns_same_as_members(std::string_view s, P ... p)
+{
+    const bool in_any = (p.matches(s) || ...);
+    const bool in_all = (p.matches(s) && ...);
+    REQUIRE((s == any_of(p...)) == in_any);
+    REQUIRE((s != any_of(p...)) == !in_any);
+    REQUIRE((s == none_of(p...)) == !in_any);
+    REQUIRE((s != none_of(p...)) == in_any);
+    REQUIRE((s == all_of(p...)) == in_all);
+    REQUIRE((s != all_of(p...)) == !in_all);
+}
+
+// Compares many more pairs of strings than DRY_COMPARISONS_SET_THRESHOLD,
+// so that the members of one side are looked up in a hash table of the
+// other.
+template <std::size_t ... I, std::size_t ... J>
+void require_string_sets_same_as_loops(const std::vector<std::string>& a,
+                                       const std::vector<std::string>& b,
+                                       std::index_sequence<I...>, std::index_sequence<J...>)
+{
+    auto in_b = [&](const std::string& s) { for (auto& t : b) if (s == t) return true; return false; };
+    const bool some = (in_b(a[I]) || ...);
+    const bool every = (in_b(a[I]) && ...);
+    const auto set = any_of(std::string_view(b[J])...);
+    const auto not_set = none_of(b[J]...);
+    REQUIRE((any_of(a[I]...) == set) == some);
+    REQUIRE((any_of(a[I]...) != set) == !some);
+    REQUIRE((all_of(a[I]...) == set) == every);
+    REQUIRE((all_of(a[I]...) != set) == !every);
+    REQUIRE((none_of(a[I]...) == set) == !some);
+    REQUIRE((none_of(a[I]...) != set) == some);
+    REQUIRE((any_of(a[I]...) == not_set) == !every);
+    REQUIRE((all_of(a[I]...) == not_set) == !some);
+    REQUIRE((any_of(a[I]...) != not_set) == every);
+    REQUIRE((all_of(a[I]...) != not_set) == some);
+    REQUIRE((any_of(a[I]...) == any_of_range(b)) == some);
+    REQUIRE((all_of(a[I]...) == any_of_range(b)) == every);
+    REQUIRE((any_of(a[I]...) == none_of_range(b)) == !every);
+    REQUIRE((all_of(a[I]...) != none_of_range(b)) == some);
+}
+
+template <typename T>
+void require_range_same_as_reference(const std::vector<T>& vs, T u)
+{
+    auto any = [&](auto op) { bool r = false; for (auto& v : vs) r = r || op(v, u); return r;};
+    auto all = [&](auto op) { bool r = true; for (auto& v : vs) r = r && op(v, u); return r;};
+    for (bool is_sorted : { false, true })
+    {
+        auto a = is_sorted ? any_of_range(vs, rollbear::sorted) : any_of_range(vs);
+        auto l = is_sorted ? all_of_range(vs, rollbear::sorted) : all_of_range(vs);
+        auto n = is_sorted ? none_of_range(vs, rollbear::sorted) : none_of_range(vs);
+        REQUIRE((a == u) == any(std::equal_to<>{}));
+        REQUIRE((u == a) == any(std::equal_to<>{}));
+        REQUIRE((a != u) == all(std::not_equal_to<>{}));
+        REQUIRE((a < u) == any(std::less<>{}));
+        REQUIRE((u > a) == any(std::less<>{}));
+        REQUIRE((a <= u) == any(std::less_equal<>{}));
+        REQUIRE((a > u) == any(std::greater<>{}));
+        REQUIRE((a >= u) == any(std::greater_equal<>{}));
+        REQUIRE((l == u) == all(std::equal_to<>{}));
+        REQUIRE((l != u) == any(std::not_equal_to<>{}));
+        REQUIRE((l < u) == all(std::less<>{}));
+        REQUIRE((l <= u) == all(std::less_equal<>{}));
+        REQUIRE((u <= l) == all(std::greater_equal<>{}));
+        REQUIRE((l > u) == all(std::greater<>{}));
+        REQUIRE((l >= u) == all(std::greater_equal<>{}));
+        REQUIRE((n == u) == !any(std::equal_to<>{}));
+        REQUIRE((n != u) == !all(std::not_equal_to<>{}));
+        REQUIRE((n < u) == !any(std::less<>{}));
+        REQUIRE((n <= u) == !any(std::less_equal<>{}));
+        REQUIRE((n > u) == !any(std::greater<>{}));
+        REQUIRE((n >= u) == !any(std::greater_equal<>{}));
+    }
+}
+
+template <typename F, typename T, typename Q>
+void require_selection_same_as_rows(const std::vector<T>& column, F f, const Q& q)
+{
+    std::vector<std::uint64_t> bits((column.size() + 63) / 64, ~std::uint64_t{});
+    rollbear::select_bits(column.data(), column.size(), f, q, bits.data());
+    std::vector<std::size_t> indices(column.size());
+    auto count = rollbear::select_indices(column.data(), column.size(), f, q, indices.data());
+    std::size_t expected_count = 0;
+    for (std::size_t i = 0; i != column.size(); ++i)
+    {
+        const bool expected = f(column[i], q);
+        REQUIRE(((bits[i / 64] >> (i % 64)) & 1U) == expected);
+        if (expected)
+        {
+            REQUIRE(expected_count < count);
+            REQUIRE(indices[expected_count++] == i);
+        }
+    }
+    REQUIRE(count == expected_count);
+    for (std::size_t i = column.size(); i != bits.size() * 64; ++i)
+    {
+        REQUIRE(((bits[i / 64] >> (i % 64)) & 1U) == 0);
+    }
+}
+
+template <typename T>
+void require_same_as_fold_for_all_probes()
+{
+    for (int u = -2; u <= 20; ++u)
+    {
+        require_same_as_fold(T(u), 1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17);
+        require_same_as_fold(T(u), 3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3);
+        require_same_as_fold(T(u), 17,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-1);
+    }
+}
+
+enum class colour : short { red, green, blue };
+
 
 int zero = 0;
 
@@ -799,6 +1417,749 @@ int main()
             REQUIRE(cond);
         }
 
+    },
+    {
+        "calling with an rvalue moves it once, and never copies it",
+        []{
+            counted::copies = 0;
+            counted::moves = 0;
+            auto r = any_of{[](const counted& c) { return c.value == 1;},
+                            [](const counted& c) { return c.value == 2;},
+                            [](const counted& c) { return c.value == 3;}}(counted{3});
+            REQUIRE(r);
+            REQUIRE(counted::copies == 0);
+            REQUIRE(counted::moves == 1);
+        }
+    },
+    {
+        "calling with an lvalue neither copies nor moves it",
+        []{
+            counted::copies = 0;
+            counted::moves = 0;
+            counted c{2};
+            REQUIRE(all_of{[](const counted& v) { return v.value > 1;},
+                           [](const counted& v) { return v.value < 3;}}(c));
+            REQUIRE(none_of{[](const counted& v) { return v.value == 1;},
+                            [](const counted& v) { return v.value == 3;}}(c));
+            REQUIRE(counted::copies == 0);
+            REQUIRE(counted::moves == 0);
+        }
+    },
+    {
+        "move only arguments are moved into the result",
+        []{
+            auto r = all_of{not_null, [](const std::unique_ptr<int>& p) { return *p == 3;}}(std::make_unique<int>(3));
+            REQUIRE(r);
+            REQUIRE(!any_of{not_null}(std::unique_ptr<int>{}));
+        }
+    },
+    {
+        "memoized callables are called at most once, and only when needed",
+        []{
+            int calls[3] = {};
+            auto r = any_of{[&](int x) { ++calls[0]; return x > 5;},
+                            [&](int x) { ++calls[1]; return x > 2;},
+                            [&](int x) { ++calls[2]; return x > 0;}}.memoized(3);
+            REQUIRE(calls[0] + calls[1] + calls[2] == 0);
+            REQUIRE(r);
+            REQUIRE(r == true);
+            REQUIRE(!(r != false));
+            REQUIRE(calls[0] == 1);
+            REQUIRE(calls[1] == 1);
+            REQUIRE(calls[2] == 0);
+            REQUIRE(all_of{identity, identity}.memoized(3) == 3);
+            REQUIRE(none_of{not_null}.memoized(std::unique_ptr<int>{}));
+        }
+    },
+    {
+        "by compares a data member, or the result of a member function, of each member",
+        []{
+            item a{1, 2}, b{3, 4};
+            auto q = all_of(a, b).by(&item::weight);
+            REQUIRE(q > 1);
+            b.weight = 0;
+            REQUIRE(!(q > 1));
+            int calls = 0;
+            auto doubled = [&](const item& i) { ++calls; return 2 * i.id; };
+            REQUIRE(!(6 == none_of(a, b, a).by(doubled)));
+            REQUIRE(calls == 3);
+            std::ostringstream os;
+            os << any_of(a, b).by(&item::id);
+            REQUIRE(os.str() == "any_of{1,3}");
+        }
+    },
+    {
+        "by on a range compares a data member of each element",
+        []{
+            require_projected_range_same_as_loop<int>();
+            require_projected_range_same_as_loop<short>();
+            require_projected_range_same_as_loop<unsigned char>();
+            require_projected_range_same_as_loop<double>();
+            require_projected_range_same_as_loop<colour>();
+            const item items[] = {{1, 2}, {3, 4}, {5, 6}};
+            std::ostringstream os;
+            os << all_of_range(items).by(&item::weight);
+            REQUIRE(os.str() == "all_of{2,4,6}");
+            struct named
+            {
+                int id;
+                std::string name;
+            };
+            const std::vector<named> people{{1, "ann"}, {2, "bo"}, {3, "cy"}};
+            REQUIRE(std::string("bo") == any_of_range(people).by(&named::name));
+            REQUIRE(std::string("di") == none_of_range(people).by(&named::name));
+        }
+    },
+    {
+        "a std::atomic is loaded once and compared as its value",
+        []{
+            std::atomic<state> s{S3};
+            const std::atomic<int> i{5};
+            REQUIRE(s == any_of(S1, S3));
+            REQUIRE(!(any_of(S1, S2) == s));
+            REQUIRE(s != none_of(S3, S40));
+            REQUIRE(s == any_of_c<S1, S3, S40>);
+            REQUIRE(i < all_of(6, 7));
+            REQUIRE(i == exactly<2>(5, 4, 5));
+            const std::vector<int> v{1, 5, 9};
+            REQUIRE(i == any_of_range(v));
+            REQUIRE(any_of(4, 5).find_first(i) == 1);
+            adaptive_any_of a(4, 5);
+            REQUIRE(i == a);
+        }
+    },
+    {
+        "compare_exchange only moves from a value in the set",
+        []{
+            std::atomic<state> s{S1};
+            REQUIRE(!compare_exchange(s, any_of(S2, S3), S40));
+            REQUIRE(s.load() == S1);
+            REQUIRE(compare_exchange(s, any_of(S1, S2), S3));
+            REQUIRE(s.load() == S3);
+            REQUIRE(compare_exchange(s, none_of(S1, S2), S0, std::memory_order_relaxed, std::memory_order_relaxed));
+            REQUIRE(s.load() == S0);
+            std::atomic<int> claimed{0};
+            std::atomic<int> wins{0};
+            std::vector<std::thread> threads;
+            for (int t = 0; t != 4; ++t)
+            {
+                threads.emplace_back([&, t] {
+                    if (compare_exchange(claimed, any_of(0), t + 1)) ++wins;
+                });
+            }
+            for (auto& t : threads) t.join();
+            REQUIRE(wins.load() == 1);
+            REQUIRE(claimed.load() == any_of(1, 2, 3, 4));
+        }
+    },
+    {
+        "find_first gives the index of the first equal member",
+        []{
+            for (int i = -200; i != 200; ++i)
+            {
+                auto first = [i](std::initializer_list<int> v) {
+                    std::size_t n = 0;
+                    for (int m : v) { if (m == i) break; ++n; }
+                    return n;
+                };
+                REQUIRE(any_of_c<1,2,3,4,5>.find_first(i) == first({1,2,3,4,5}));
+                REQUIRE(any_of_c<-3,1,7,60,1,-3>.find_first(i) == first({-3,1,7,60,1,-3}));
+                REQUIRE(any_of_c<-100,-3,1,7,60,100,99,-150>.find_first(i) == first({-100,-3,1,7,60,100,99,-150}));
+                REQUIRE(any_of(-100,-3,1,7,60,100,99,-150).find_first(i) == first({-100,-3,1,7,60,100,99,-150}));
+                int a = 7, b = -3, c = 7;
+                REQUIRE(all_of(a, b, c).find_first(i) == first({7,-3,7}));
+            }
+        }
+    },
+    {
+        "which gives the index and result of the first true callable",
+        []{
+            int calls[3] = {};
+            auto q = any_of([&](int x) -> const char* { ++calls[0]; return x > 5 ? "big" : nullptr;},
+                            [&](int x) -> const char* { ++calls[1]; return x > 2 ? "mid" : nullptr;},
+                            [&](int x) -> const char* { ++calls[2]; return x > 0 ? "small" : nullptr;});
+            auto r = q(3).which();
+            REQUIRE(r.index == 1);
+            REQUIRE(std::string_view(r.value) == "mid");
+            REQUIRE(calls[0] == 1);
+            REQUIRE(calls[1] == 1);
+            REQUIRE(calls[2] == 0);
+            r = q(0).which();
+            REQUIRE(r.index == 3);
+            REQUIRE(r.value == nullptr);
+            auto m = q.memoized(7);
+            REQUIRE(m);
+            REQUIRE(m.which().index == 0);
+            REQUIRE(calls[0] == 3);
+        }
+    },
+    {
+        "counting quantifiers give the same results as counting each member",
+        []{
+            for (int u = -1; u != 5; ++u)
+            {
+                require_counts_same_as_loop(u, 1, 2, 3);
+                require_counts_same_as_loop(u, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 3, 3, 4);
+                require_counts_same_as_loop(short(u), short(0), short(1), short(3), short(3), short(3), short(1),
+                                            short(0), short(1), short(3), short(3), short(1), short(0));
+                require_counts_same_as_loop(u, 0L, 1, 2LL, short(3), 2L, 1, 3);
+                int a[] = {0, 1, 2, 2, 0, 4, 3, 2};
+                require_counts_same_as_loop(u, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+                require_counts_same_as_loop(u / 2.0, 0.0, 0.5, 0.5, 1.0, 1.5, 1.5, 1.5, 2.0, 0.0, 0.5, 1.5, 1.0);
+            }
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            require_counts_same_as_loop(nan, 0.0, 0.5, 0.5, 1.0, 1.5, 1.5, 1.5, 2.0, nan, nan, nan, nan);
+            for (std::string_view s : {"GET", "PUT", "HEAD"})
+            {
+                require_counts_same_as_loop(s, "GET", "PUT", "GET", "POST", "GET", "PUT", "GET");
+            }
+        }
+    },
+#if defined(__cpp_lib_three_way_comparison)
+    {
+        "<=> gives the same results as the comparison operators",
+        []{
+            for (int u = -1; u != 5; ++u)
+            {
+                require_orderings_same_as_operators(u, 1, 2, 3);
+                require_orderings_same_as_operators(u, 0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 4);
+                require_orderings_same_as_operators(u, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 3, 3, 4);
+                require_orderings_same_as_operators(u, 0L, 1, 2LL, short(3), 2L, 1, 3);
+                require_orderings_same_as_operators(u, 1, 1, 1, 1, 1, 1, 1, 1);
+                require_orderings_same_as_operators(u / 2.0, 0.0, 0.5, 0.5, 1.0, 1.5, 1.5, 1.5, 2.0, 0.0, 0.5, 1.5, 1.0);
+                require_orderings_same_as_operators(u);
+            }
+            REQUIRE(((any_of_c<1, 2, 3> <=> 2) == 0));
+            REQUIRE(((all_of_c<1, 2, 3> <=> 0) > 0));
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            require_orderings_same_as_operators(nan, 0.0, 0.5, 0.5, 1.0, 1.5, 1.5, 1.5, 2.0);
+            require_orderings_same_as_operators(1.0, 0.0, 0.5, 0.5, 1.0, 1.5, 1.5, 1.5, 2.0, nan, nan, nan, nan);
+            for (std::string_view s : {"GET", "PUT", "HEAD"})
+            {
+                require_orderings_same_as_operators(s, std::string_view("GET"), std::string_view("PUT"));
+            }
+        }
+    },
+#endif
+    {
+        "counting quantifiers of callables call each at most once, and only when needed",
+        []{
+            int calls[3] = {};
+            auto r = at_least<2>([&](int x) { ++calls[0]; return x > 5;},
+                                 [&](int x) { ++calls[1]; return x > 2;},
+                                 [&](int x) { ++calls[2]; return x > 0;}).memoized(3);
+            REQUIRE(calls[0] + calls[1] + calls[2] == 0);
+            REQUIRE(r);
+            REQUIRE(r == true);
+            REQUIRE(calls[0] == 1);
+            REQUIRE(calls[1] == 1);
+            REQUIRE(calls[2] == 1);
+            REQUIRE(!one_of([&](int x) { ++calls[0]; return x > 0;},
+                            [&](int x) { ++calls[1]; return x > 1;},
+                            [&](int x) { ++calls[2]; return x > 2;})(3));
+            REQUIRE(calls[0] == 2);
+            REQUIRE(calls[1] == 2);
+            REQUIRE(calls[2] == 1);
+        }
+    },
+    {
+        "print counting quantifiers",
+        []{
+            std::ostringstream os;
+            os << at_least<2>(1, 2, 3) << ' ' << at_most<1>("a", "b") << ' ' << exactly<2>(1.5, 2)
+               << ' ' << one_of(1) << ' ' << rollbear::count_of<1, 2, int>(3);
+            REQUIRE(os.str() == "at_least<2>{1,2,3} at_most<1>{a,b} exactly<2>{1.5,2} one_of{1} count_of<1,2>{3}");
+        }
+    },
+    {
+        "parallel evaluation gives the same results as calling in sequence",
+        []{
+            rollbear::parallel::pool pool(3);
+            auto gt2 = [](int x) { return x > 2;};
+            auto lt5 = [](int x) { return x < 5;};
+            auto odd = [](int x) { return x % 2 == 1;};
+            for (int x = 0; x != 8; ++x)
+            {
+                REQUIRE(evaluate(pool, any_of{gt2, lt5, odd}, x) == bool(any_of{gt2, lt5, odd}(x)));
+                REQUIRE(evaluate(pool, all_of{gt2, lt5, odd}, x) == bool(all_of{gt2, lt5, odd}(x)));
+                REQUIRE(evaluate(pool, none_of{gt2, odd}, x) == bool(none_of{gt2, odd}(x)));
+            }
+        }
+    },
+    {
+        "parallel evaluation returns when decided, and cancels the rest",
+        []{
+            using namespace std::chrono_literals;
+            rollbear::parallel::pool pool(2);
+            auto slow = [](int, const rollbear::parallel::cancellation& c) {
+                for (int i = 0; i != 10000 && !c.requested(); ++i) std::this_thread::sleep_for(1ms);
+                return c.requested();
+            };
+            auto fast = [](int x) { return x == 3;};
+            const auto start = std::chrono::steady_clock::now();
+            REQUIRE(evaluate(pool, any_of{slow, fast}, 3));
+            REQUIRE(!evaluate(pool, all_of{slow, fast}, 4));
+            REQUIRE(std::chrono::steady_clock::now() - start < 5s);
+        }
+    },
+    {
+        "parallel evaluation rethrows exceptions",
+        []{
+            rollbear::parallel::pool pool(2);
+            auto throws = [](int) -> bool { throw std::runtime_error("oops");};
+            auto no = [](int) { return false;};
+            bool thrown = false;
+            try { evaluate(pool, any_of{no, throws}, 1); }
+            catch (const std::runtime_error&) { thrown = true; }
+            REQUIRE(thrown);
+        }
+    },
+    {
+        "parallel evaluation can be nested in a task of the same pool",
+        []{
+            rollbear::parallel::pool pool(1);
+            auto no = [](int) { return false;};
+            auto nested = [&pool, no](int x) { return evaluate(pool, any_of{no, no}, x);};
+            REQUIRE(evaluate(pool, none_of{nested, nested}, 1));
+        }
+    },
+    {
+        "pool tasks run by the submitting thread are each run once",
+        []{
+            std::atomic<int> runs{0};
+            {
+                rollbear::parallel::pool pool(2);
+                std::thread submitter([&] {
+                    for (int i = 0; i != 10000; ++i) pool.submit([&runs] { ++runs; });
+                });
+                while (runs < 10000) pool.try_run_one();
+                submitter.join();
+            }
+            REQUIRE(runs == 10000);
+        }
+    },
+#if defined(COROUTINES)
+    {
+        "awaited quantifiers give the same results as over the values",
+        []{
+            for (int i = 0; i != 8; ++i)
+            {
+                const bool a = i & 1, b = i & 2, c = i & 4;
+                auto check = [&]() -> rollbear::coro::task<bool> {
+                    const bool any = co_await any_of(after(2, a), after(0, b), after(1, c));
+                    const bool all = co_await all_of(after(2, a), after(0, b), after(1, c));
+                    const bool none = co_await none_of(after(2, a), after(0, b), after(1, c));
+                    co_return any == bool(any_of(a, b, c)) &&
+                              all == bool(all_of(a, b, c)) &&
+                              none == bool(none_of(a, b, c));
+                };
+                REQUIRE(executor.run(check()));
+            }
+        }
+    },
+    {
+        "awaited quantifiers resume as soon as they are decided",
+        []{
+            coroutines_finished = 0;
+            int finished_when_decided = -1;
+            auto check = [&]() -> rollbear::coro::task<bool> {
+                const bool r = co_await any_of(after(5, false), after(1, true), after(10, true));
+                finished_when_decided = coroutines_finished;
+                co_return r;
+            };
+            REQUIRE(executor.run(check()));
+            REQUIRE(finished_when_decided == 1);
+            REQUIRE(coroutines_finished == 3);
+        }
+    },
+    {
+        "awaited quantifiers rethrow exceptions",
+        []{
+            auto check = []() -> rollbear::coro::task<bool> {
+                co_return co_await all_of(after(3, true), throws_after(1));
+            };
+            bool thrown = false;
+            try { executor.run(check()); }
+            catch (const std::runtime_error&) { thrown = true; }
+            REQUIRE(thrown);
+        }
+    },
+#endif
+    {
+        "adaptive_any_of gives the same results as any_of",
+        []{
+            adaptive_any_of a{1, 3, 5, 7, 9};
+            const auto q = any_of(1, 3, 5, 7, 9);
+            std::uint32_t state = 1;
+            for (int n = 0; n != 5000; ++n)
+            {
+                state = state * 1103515245U + 12345U;
+                // Mostly 9, to make it move first.
+                const int x = (state >> 16) % 4 ? 9 : int((state >> 8) % 12);
+                REQUIRE((x == a) == (x == q));
+                REQUIRE((x != a) == (x != q));
+                REQUIRE((x < a) == (x < q));
+                REQUIRE((x <= a) == (x <= q));
+                REQUIRE((x > a) == (x > q));
+                REQUIRE((x >= a) == (x >= q));
+                REQUIRE((a == x) == (q == x));
+            }
+        }
+    },
+    {
+        "adaptive_any_of compares the most frequently deciding member first",
+        []{
+            adaptive_any_of a{S0, S1, S2, S3};
+            REQUIRE(a.evaluation_order()[0] == 0);
+            for (int n = 0; n != 1000; ++n) REQUIRE(S3 == a);
+            REQUIRE(a.evaluation_order()[0] == 3);
+            for (int n = 0; n != 3000; ++n) REQUIRE(S2 == a);
+            REQUIRE(a.evaluation_order()[0] == 2);
+            std::ostringstream os;
+            os << a;
+            REQUIRE(os.str() == "any_of{0,1,2,3}");
+        }
+    },
+    {
+        "adaptive_any_of can be compared from several threads at once",
+        []{
+            const adaptive_any_of a{1, 3, 5, 7, 9};
+            std::atomic<int> wrong{0};
+            auto compare = [&](int seed) {
+                for (int n = 0; n != 20000; ++n)
+                {
+                    const int x = (n * seed) % 11;
+                    if ((x == a) != (x == any_of(1, 3, 5, 7, 9))) ++wrong;
+                }
+            };
+            std::thread t1(compare, 7), t2(compare, 3);
+            compare(9);
+            t1.join();
+            t2.join();
+            REQUIRE(wrong == 0);
+        }
+    },
+    {
+        "print any_of_c",
+        []{
+            std::ostringstream os;
+            os << any_of_c<1,3,5>;
+            auto s = os.str();
+            REQUIRE(s == "any_of{1,3,5}");
+        }
+    },
+    {
+        "any_of_c gives the same results as any_of",
+        []{
+            for (int i = -200; i <= 200; ++i)
+            {
+                REQUIRE((i == any_of_c<1,2,3,4,5>) == (i == any_of(1,2,3,4,5)));
+                REQUIRE((i == any_of_c<-3,1,7,60>) == (i == any_of(-3,1,7,60)));
+                REQUIRE((i == any_of_c<-100,-3,1,7,60,100,99,-150>) == (i == any_of(-100,-3,1,7,60,100,99,-150)));
+                REQUIRE((i != any_of_c<-100,-3,1,7,60,100,99,-150>) == (i != any_of(-100,-3,1,7,60,100,99,-150)));
+                REQUIRE((i < any_of_c<-100,-3,1,7>) == (i < any_of(-100,-3,1,7)));
+                REQUIRE((i <= all_of_c<-100,-3,1,7>) == (i <= all_of(-100,-3,1,7)));
+                REQUIRE((i > none_of_c<-100,-3,1,7>) == (i > none_of(-100,-3,1,7)));
+                REQUIRE((i >= all_of_c<-100,-3,1,7>) == (i >= all_of(-100,-3,1,7)));
+            }
+            const auto u = std::numeric_limits<unsigned>::max();
+            REQUIRE(u == any_of_c<0U, u>);
+            REQUIRE(0U == any_of_c<0U, u>);
+            REQUIRE(1U != any_of_c<0U, u>);
+            REQUIRE(u - 1 == any_of_c<u - 2, u - 1, u>);
+            REQUIRE(3U != any_of_c<u - 2, u - 1, u>);
+        }
+    },
+    {
+        "ranges give the same results as a loop",
+        []{
+            std::vector<int> vs;
+            for (int size = 0; size != 70; ++size)
+            {
+                for (int u = -1; u <= size + 1; ++u)
+                {
+                    require_range_same_as_reference(vs, u);
+                }
+                vs.push_back(size);
+            }
+            std::vector<int> same(33, 4);
+            for (int u = 3; u <= 5; ++u)
+            {
+                require_range_same_as_reference(same, u);
+            }
+            std::vector<std::string> strings{"bar", "baz", "foo"};
+            for (auto u : { "a", "bar", "bay", "baz", "foo", "fop" })
+            {
+                require_range_same_as_reference(strings, std::string(u));
+            }
+        }
+    },
+    {
+        "print ranges",
+        []{
+            std::vector<int> vs{1,3,5};
+            std::ostringstream os;
+            os << any_of_range(vs) << all_of_range(vs) << none_of_range(vs.data(), 0);
+            auto s = os.str();
+            REQUIRE(s == "any_of{1,3,5}all_of{1,3,5}none_of{}");
+        }
+    },
+    {
+        "string literals give the same results as comparing one by one",
+        []{
+            const auto q = any_of("GET", "PUT", "POST", "DELETE", "a", "", "0123456789abcdef",
+                                  "0123456789abcdefg", "0123456789abcdeg");
+            const char* names[] = { "GET", "PUT", "POST", "DELETE", "a", "", "0123456789abcdef",
+                                    "0123456789abcdefg", "0123456789abcdeg" };
+            std::vector<std::string> probes(std::begin(names), std::end(names));
+            for (auto n : names)
+            {
+                std::string s = n;
+                for (auto& c : s) probes.push_back((c = char(c + 1), s));
+                probes.push_back(std::string(n) + "x");
+                probes.push_back(std::string("x") + n);
+            }
+            for (auto& s : probes)
+            {
+                bool any = false;
+                for (auto n : names) any = any || s == n;
+                REQUIRE((s == q) == any);
+                REQUIRE((s != q) == !any);
+                REQUIRE((s != all_of("GET", "PUT")) == (s != "GET" || s != "PUT"));
+                REQUIRE((std::string_view(s) == q) == any);
+                REQUIRE((q == s) == any);
+                REQUIRE((s == none_of("GET", "PUT", "POST", "DELETE", "a", "", "0123456789abcdef",
+                                      "0123456789abcdefg", "0123456789abcdeg")) == !any);
+                REQUIRE((s == all_of("GET", std::string_view("GET"))) == (s == "GET"));
+            }
+        }
+    },
+    {
+        "icase strings give the same results as comparing lower cased copies",
+        []{
+            auto lower = [](std::string s) {
+                for (auto& c : s) if (c >= 'A' && c <= 'Z') c = char(c - 'A' + 'a');
+                return s;
+            };
+            const std::string long_name = "X-A-Header-Name-Longer-Than-Thirty-Two-Characters";
+            const std::string names[] = { "Content-Type", "content-length", "HOST", "a", "", "[@`{",
+                                          "0123456789ABCDEF", "0123456789abcdefghijklmnopqrstuv",
+                                          long_name };
+            const auto q = any_of(rollbear::icase(names[0]), rollbear::icase(names[1]), rollbear::icase(names[2]),
+                                  rollbear::icase(names[3]), rollbear::icase(names[4]), rollbear::icase(names[5]),
+                                  rollbear::icase(names[6]), rollbear::icase(names[7]), rollbear::icase(names[8]));
+            std::vector<std::string> probes(std::begin(names), std::end(names));
+            for (auto& n : names)
+            {
+                std::string s = n;
+                for (auto& c : s) probes.push_back((c = char(c ^ 0x20), s));
+                probes.push_back(lower(n));
+                probes.push_back(n + "x");
+                probes.push_back("x" + n);
+            }
+            for (auto& s : probes)
+            {
+                bool any = false;
+                for (auto& n : names) any = any || lower(s) == lower(n);
+                REQUIRE((s == q) == any);
+                REQUIRE((s != q) == !any);
+                REQUIRE((std::string_view(s) == q) == any);
+                REQUIRE((q == s) == any);
+                REQUIRE((s == none_of(rollbear::icase("content-type"), rollbear::icase("HOST"))) ==
+                        (lower(s) != "content-type" && lower(s) != "host"));
+                REQUIRE((s == all_of(rollbear::icase("host"), rollbear::icase("Host"))) == (lower(s) == "host"));
+                REQUIRE((s != all_of(rollbear::icase("host"), rollbear::icase("a"))) ==
+                        (lower(s) != "host" || lower(s) != "a"));
+            }
+            std::ostringstream os;
+            os << any_of(rollbear::icase("Host"), rollbear::icase("accept"));
+            REQUIRE(os.str() == "any_of{icase(\"Host\"),icase(\"accept\")}");
+        }
+    },
+    {
+        "const char* compared with string literals compares pointers",
+        []{
+            const char get[] = "GET";
+            const char* p = get;
+            REQUIRE(p != any_of("GET", "PUT"));
+            REQUIRE(std::string(p) == any_of("GET", "PUT"));
+        }
+    },
+    {
+        "print string literals",
+        []{
+            std::ostringstream os;
+            os << any_of("GET", std::string_view("PUT"));
+            auto s = os.str();
+            REQUIRE(s == "any_of{GET,PUT}");
+        }
+    },
+    {
+        "selecting from a column gives the same results as comparing each row",
+        []{
+            for (std::size_t size : { 0, 1, 63, 64, 65, 200 })
+            {
+                std::vector<int> column(size);
+                for (std::size_t i = 0; i != size; ++i) column[i] = static_cast<int>(i * 7 % 11);
+                require_selection_same_as_rows(column, std::equal_to<>{}, any_of(1, 3, 5));
+                require_selection_same_as_rows(column, std::not_equal_to<>{}, any_of(1, 3, 5));
+                require_selection_same_as_rows(column, std::equal_to<>{}, none_of(1, 3, 5));
+                require_selection_same_as_rows(column, std::not_equal_to<>{}, none_of(1, 3, 5));
+                require_selection_same_as_rows(column, std::equal_to<>{}, all_of(3, 3));
+                require_selection_same_as_rows(column, std::not_equal_to<>{}, all_of(3, 3));
+                require_selection_same_as_rows(column, std::less<>{}, all_of(4, 8));
+                require_selection_same_as_rows(column, std::less_equal<>{}, any_of(4, 8));
+                require_selection_same_as_rows(column, std::greater<>{}, none_of(4, 8));
+                require_selection_same_as_rows(column, std::greater_equal<>{}, all_of(4, 8));
+                require_selection_same_as_rows(column, std::equal_to<>{}, any_of_c<1, 3, 5>);
+                require_selection_same_as_rows(column, std::equal_to<>{}, any_of(1L, 3.0));
+                std::vector<double> doubles(column.begin(), column.end());
+                require_selection_same_as_rows(doubles, std::less<>{}, any_of(2.0, 3.5));
+                std::vector<std::string> strings(size, "foo");
+                if (size) strings[size / 2] = "bar";
+                require_selection_same_as_rows(strings, std::equal_to<>{}, any_of(std::string("bar"), std::string("baz")));
+            }
+        }
+    },
+    {
+        "homogeneous int packs give the same results as the scalar fold",
+        []{
+            require_same_as_fold_for_all_probes<int>();
+            require_same_as_fold_for_all_probes<unsigned>();
+            require_same_as_fold_for_all_probes<long long>();
+            require_same_as_fold_for_all_probes<std::uint16_t>();
+            require_same_as_fold_for_all_probes<signed char>();
+            require_same_as_fold_for_all_probes<unsigned char>();
+        }
+    },
+    {
+        "homogeneous floating point packs give the same results as the scalar fold",
+        []{
+            require_same_as_fold_for_all_probes<float>();
+            require_same_as_fold_for_all_probes<double>();
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            require_same_as_fold(nan, 1.0, 2.0, 3.0, 4.0, nan, 6.0, 7.0, 8.0, 9.0);
+            require_same_as_fold(1.0, 1.0, 2.0, 3.0, 4.0, nan, 6.0, 7.0, 8.0, 9.0);
+            require_same_as_fold(5.0, nan, nan, nan, nan, nan, nan, nan, nan, nan);
+        }
+    },
+    {
+        "homogeneous enum and bool packs give the same results as the scalar fold",
+        []{
+            using c = colour;
+            require_same_as_fold(c::green, c::red, c::red, c::red, c::red, c::red, c::red, c::red, c::red,
+                                 c::red, c::red, c::red, c::red, c::red, c::red, c::red, c::blue);
+            require_same_as_fold(c::blue, c::red, c::red, c::red, c::red, c::red, c::red, c::red, c::red,
+                                 c::red, c::red, c::red, c::red, c::red, c::red, c::red, c::blue);
+            require_same_as_fold(true, false, false, false, false, false, false, false, false,
+                                 false, false, false, false, false, false, false, false, false);
+            require_same_as_fold(false, false, false, false, false, false, false, false, false,
+                                 false, false, false, false, false, false, false, false, true);
+        }
+    },
+    {
+        "interval members give the same results as testing each interval",
+        []{
+            for (int i = -2; i <= 24; ++i)
+            {
+                const double u = i / 2.0;
+                require_intervals_same_as_members(u, between(0, 2), between(1, 3));
+                require_intervals_same_as_members(u, between(5.0, 6.0), between(0.0, 1.0), between(2.0, 2.0),
+                                                  between(1.0, 2.0), between(9.0, 8.0), between(3.0, 3.5));
+                require_intervals_same_as_members(u, half_open(5, 6), half_open(0, 1), half_open(2, 2),
+                                                  half_open(1, 2), half_open(9, 8), half_open(3, 4));
+                require_intervals_same_as_members(u, strictly_between(5, 6), strictly_between(0, 1),
+                                                  strictly_between(2, 2), strictly_between(1, 2),
+                                                  strictly_between(0, 4), strictly_between(9, 11));
+                require_intervals_same_as_members(u, rollbear::interval<double, rollbear::endpoint::open>{1, 2},
+                                                  rollbear::interval<double, rollbear::endpoint::open>{0, 1},
+                                                  rollbear::interval<double, rollbear::endpoint::open>{4, 5},
+                                                  rollbear::interval<double, rollbear::endpoint::open>{3, 4},
+                                                  rollbear::interval<double, rollbear::endpoint::open>{7, 6});
+                require_intervals_same_as_members(static_cast<int>(u), between(10, 11), between(1, 1), between(3, 5),
+                                                  between(5, 7), between(9, 10));
+            }
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            require_intervals_same_as_members(nan, between(0.0, 1.0), between(1.0, 2.0), between(3.0, 4.0),
+                                              between(5.0, 6.0), between(7.0, 8.0));
+            require_intervals_same_as_members(0.5, between(0.0, 1.0), between(nan, 2.0), between(3.0, nan),
+                                              between(5.0, 6.0), between(7.0, 8.0));
+        }
+    },
+    {
+        "text pattern members give the same results as matching each pattern",
+        []{
+            const std::string long_text(40, 'a');
+            const std::string longer_text = long_text + "b";
+            const std::string_view strings[] = {
+                "", "a", "ab", "abc", "abcd", "ba", "cab", "/api/", "/api/v1", "/ap", "x/api/",
+                "he said hers", "ushers", "shers", "his", "she", "abab", "babab", "aaaa", long_text,
+                longer_text
+            };
+            for (std::string_view s : strings)
+            {
+                require_patterns_same_as_members(s, starts_with("ab"), ends_with("ab"));
+                require_patterns_same_as_members(s, starts_with("/api/"), starts_with("/ap"), starts_with("ab"),
+                                                 starts_with("abcd"), starts_with("b"));
+                require_patterns_same_as_members(s, ends_with("ab"), ends_with("b"), ends_with("hers"),
+                                                 ends_with("s"), ends_with("abab"));
+                require_patterns_same_as_members(s, contains("he"), contains("she"), contains("his"),
+                                                 contains("hers"), contains("bab"));
+                require_patterns_same_as_members(s, starts_with("ab"), ends_with("ab"), contains("he"),
+                                                 contains("api"), starts_with("h"), ends_with("rs"));
+                require_patterns_same_as_members(s, starts_with("zz"), ends_with("zz"), contains(""),
+                                                 contains("q"), starts_with("y"));
+                require_patterns_same_as_members(s, starts_with(long_text), ends_with("b"), contains("cab"),
+                                                 starts_with("ab"), contains(long_text));
+            }
+        }
+    },
+    {
+        "print text patterns",
+        []{
+            std::ostringstream os;
+            os << any_of(starts_with("/api/"), ends_with(".json"), contains("v2"));
+            REQUIRE(os.str() == "any_of{starts_with(\"/api/\"),ends_with(\".json\"),contains(\"v2\")}");
+        }
+    },
+    {
+        "print intervals",
+        []{
+            std::ostringstream os;
+            os << any_of(between(1, 5), half_open(100, 200), strictly_between(0.5, 1.5),
+                         rollbear::interval<int, rollbear::endpoint::open>{7, 9});
+            REQUIRE(os.str() == "any_of{[1,5],[100,200),(0.5,1.5),(7,9]}");
+        }
+    },
+    {
+        "quantifiers of strings compared as sets give the same results as comparing each pair",
+        []{
+            auto strings = [](std::size_t n, std::size_t first, std::size_t step) {
+                std::vector<std::string> v;
+                for (std::size_t i = 0; i != n; ++i) v.push_back("key-" + std::to_string(first + i * step));
+                return v;
+            };
+            const auto set = strings(200, 0, 2);
+            for (const auto& probe : { strings(30, 1, 2), strings(30, 0, 4), strings(30, 20, 4) })
+            {
+                require_string_sets_same_as_loops(probe, set, std::make_index_sequence<30>{},
+                                                  std::make_index_sequence<200>{});
+                require_string_sets_same_as_loops(set, probe, std::make_index_sequence<200>{},
+                                                  std::make_index_sequence<30>{});
+            }
+            auto duplicated = strings(30, 0, 2);
+            for (auto& s : duplicated) s = duplicated[0];
+            require_string_sets_same_as_loops(duplicated, set, std::make_index_sequence<30>{},
+                                              std::make_index_sequence<200>{});
+            require_string_sets_same_as_loops(set, duplicated, std::make_index_sequence<200>{},
+                                              std::make_index_sequence<30>{});
+        }
+    },
+    {
+        "packs too large to fold give the same results as the fold",
+        []{
+            require_large_same_as_fold(std::make_index_sequence<large>{});
+        }
     }
 
   };